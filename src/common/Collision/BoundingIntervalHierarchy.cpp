@@ -250,28 +250,23 @@ bool BIH::writeToFile(FILE* wf) const
     check += fwrite(&bounds.low(), sizeof(float), 3, wf);
     check += fwrite(&bounds.high(), sizeof(float), 3, wf);
     check += fwrite(&treeSize, sizeof(uint32), 1, wf);
-    check += fwrite(&tree[0], sizeof(uint32), treeSize, wf);
+    check += fwrite(tree.data(), sizeof(uint32), treeSize, wf);
     count = objects.size();
     check += fwrite(&count, sizeof(uint32), 1, wf);
-    check += fwrite(&objects[0], sizeof(uint32), count, wf);
+    check += fwrite(objects.data(), sizeof(uint32), count, wf);
     return check == (3 + 3 + 2 + treeSize + count);
 }
 
-bool BIH::readFromFile(FILE* rf)
+bool BIH::readFromFile(VMAP::VMapFileReader& reader)
 {
-    uint32 treeSize;
+    uint32 treeSize = 0, count = 0;
     G3D::Vector3 lo, hi;
-    uint32 check=0, count=0;
-    check += fread(&lo, sizeof(float), 3, rf);
-    check += fread(&hi, sizeof(float), 3, rf);
+    if (!reader.Read(lo) || !reader.Read(hi))
+        return false;
+
     bounds = G3D::AABox(lo, hi);
-    check += fread(&treeSize, sizeof(uint32), 1, rf);
-    tree.resize(treeSize);
-    check += fread(&tree[0], sizeof(uint32), treeSize, rf);
-    check += fread(&count, sizeof(uint32), 1, rf);
-    objects.resize(count); // = new uint32[nObjects];
-    check += fread(&objects[0], sizeof(uint32), count, rf);
-    return uint64(check) == uint64(3 + 3 + 1 + 1 + uint64(treeSize) + uint64(count));
+    return reader.Read(treeSize) && reader.Map(tree, treeSize)
+        && reader.Read(count) && reader.Map(objects, count);
 }
 
 void BIH::BuildStats::updateLeaf(int depth, int n)
@@ -23,14 +23,17 @@
 #include "G3D/AABox.h"
 
 #include "Define.h"
+#include "VMapFile.h"
 
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <emmintrin.h>
 
 #define MAX_STACK_SIZE 64
+#define MAX_RAY_PACKET_SIZE 8 // multiple of 4, the SSE2 register width
 
 static inline uint32 floatToRawIntBits(float f)
 {
@@ -71,11 +74,9 @@ class TC_COMMON_API BIH
     private:
         void init_empty()
         {
-            tree.clear();
-            objects.clear();
             // create space for the first node
-            tree.push_back(3u << 30u); // dummy leaf
-            tree.insert(tree.end(), 2, 0);
+            tree.Assign({ 3u << 30u, 0, 0 }); // dummy leaf
+            objects.Assign({ });
         }
     public:
         BIH() { init_empty(); }
@@ -106,11 +107,8 @@ class TC_COMMON_API BIH
             if (printStats)
                 stats.printStats();
 
-            objects.resize(dat.numPrims);
-            for (uint32 i=0; i<dat.numPrims; ++i)
-                objects[i] = dat.indices[i];
-            //nObjects = dat.numPrims;
-            tree = tempTree;
+            objects.Assign(std::vector<uint32>(dat.indices, dat.indices + dat.numPrims));
+            tree.Assign(std::move(tempTree));
             delete[] dat.primBound;
             delete[] dat.indices;
         }
@@ -255,6 +253,227 @@ class TC_COMMON_API BIH
             }
         }
 
+        /**
+        Traverses the tree once for up to MAX_RAY_PACKET_SIZE rays, a node is visited while any ray of the packet still
+        passes through it. Every ray stops at its first hit like intersectRay with stopAtFirst set, node intervals are
+        computed for 4 rays at once with SSE2.
+        Children are visited in the order of the first ray of the packet, packets should hold rays of similar direction.
+        intersectCallback(ray, entry, maxDist, stopAtFirst) is called for each ray and object of the visited leaves.
+        Returns the mask of rays that hit something within their maxDist.
+        */
+        template<typename RayCallback>
+        uint32 intersectRayPacket(G3D::Ray const* rays, float* maxDist, uint32 count, RayCallback& intersectCallback) const
+        {
+            count = std::min<uint32>(count, MAX_RAY_PACKET_SIZE);
+
+            float org[3][MAX_RAY_PACKET_SIZE] = { };
+            float invDir[3][MAX_RAY_PACKET_SIZE] = { };
+            float dirInf[3][MAX_RAY_PACKET_SIZE] = { };     // +inf for negative directions, -inf otherwise
+            float intervalMin[MAX_RAY_PACKET_SIZE] = { };
+            float intervalMax[MAX_RAY_PACKET_SIZE] = { };
+            uint32 mask = 0;
+            uint32 hitMask = 0;
+
+            // clip every ray against the tree bounds, same as intersectRay
+            for (uint32 r = 0; r < count; ++r)
+            {
+                float rayMin = -1.f;
+                float rayMax = -1.f;
+                bool missed = false;
+                for (int i = 0; i < 3; ++i)
+                {
+                    float dir = rays[r].direction()[i];
+                    org[i][r] = rays[r].origin()[i];
+                    invDir[i][r] = 1.f / dir;
+                    dirInf[i][r] = (floatToRawIntBits(dir) >> 31) ? G3D::finf() : -G3D::finf();
+                    if (G3D::fuzzyNe(dir, 0.0f))
+                    {
+                        float t1 = (bounds.low()[i] - org[i][r]) * invDir[i][r];
+                        float t2 = (bounds.high()[i] - org[i][r]) * invDir[i][r];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > rayMin)
+                            rayMin = t1;
+                        if (t2 < rayMax || rayMax < 0.f)
+                            rayMax = t2;
+                        if (rayMax <= 0 || rayMin >= maxDist[r])
+                            missed = true;
+                    }
+                }
+
+                if (missed || rayMin > rayMax)
+                    continue;
+
+                intervalMin[r] = std::max(rayMin, 0.f);
+                intervalMax[r] = std::min(rayMax, maxDist[r]);
+                mask |= 1 << r;
+            }
+
+            if (!mask)
+                return 0;
+
+            // the packet enters the right child of a node first on axes the first ray goes in negative direction
+            uint32 first = 0;
+            while (!(mask & (1 << first)))
+                ++first;
+
+            uint32 offsetNear[3];
+            uint32 offsetFar3[3];
+            float nearSign[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                bool negative = dirInf[i][first] > 0.f;
+                offsetNear[i] = negative ? 2 : 1;
+                offsetFar3[i] = negative ? 0 : 3;
+                nearSign[i] = negative ? -1.f : 1.f;
+            }
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            uint32 node = 0;
+
+            while (true)
+            {
+                while (mask)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    uint32 offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, rays with the packet direction have (-inf, t] of the near child
+                            // and [t, +inf) of the far one, the others the opposite. The far interval is written to the
+                            // top of the stack and only kept if the near child is visited too
+                            float clipNear = intBitsToFloat(tree[node + offsetNear[axis]]);
+                            float clipFar = intBitsToFloat(tree[node + 3 - offsetNear[axis]]);
+                            float sign = nearSign[axis];
+                            PacketStackNode& pushed = stack[stackPos];
+                            uint32 nearMask = 0;
+                            uint32 farMask = 0;
+                            for (uint32 r = 0; r < MAX_RAY_PACKET_SIZE; r += 4)
+                            {
+                                __m128 o = _mm_loadu_ps(&org[axis][r]);
+                                __m128 id = _mm_loadu_ps(&invDir[axis][r]);
+                                __m128 nearInf = _mm_mul_ps(_mm_loadu_ps(&dirInf[axis][r]), _mm_set1_ps(sign));
+                                __m128 farInf = _mm_sub_ps(_mm_setzero_ps(), nearInf);
+                                __m128 tNear = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(clipNear), o), id);
+                                __m128 tFar = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(clipFar), o), id);
+                                __m128 iMin = _mm_loadu_ps(&intervalMin[r]);
+                                __m128 iMax = _mm_loadu_ps(&intervalMax[r]);
+                                // min/max return their second operand for NaN (0 * inf of a ray lying in the split plane),
+                                // the operand order keeps such a ray's interval unchanged for both children, like intersectRay
+                                __m128 farMin = _mm_max_ps(_mm_min_ps(farInf, tFar), iMin);
+                                __m128 farMax = _mm_min_ps(_mm_max_ps(farInf, tFar), iMax);
+                                __m128 nearMin = _mm_max_ps(_mm_min_ps(nearInf, tNear), iMin);
+                                __m128 nearMax = _mm_min_ps(_mm_max_ps(nearInf, tNear), iMax);
+                                _mm_storeu_ps(&pushed.tnear[r], farMin);
+                                _mm_storeu_ps(&pushed.tfar[r], farMax);
+                                _mm_storeu_ps(&intervalMin[r], nearMin);
+                                _mm_storeu_ps(&intervalMax[r], nearMax);
+                                nearMask |= uint32(_mm_movemask_ps(_mm_cmple_ps(nearMin, nearMax))) << r;
+                                farMask |= uint32(_mm_movemask_ps(_mm_cmple_ps(farMin, farMax))) << r;
+                            }
+
+                            nearMask &= mask;
+                            farMask &= mask;
+                            if (!nearMask)
+                            {
+                                // rays pass through far node only
+                                std::copy(pushed.tnear, pushed.tnear + MAX_RAY_PACKET_SIZE, intervalMin);
+                                std::copy(pushed.tfar, pushed.tfar + MAX_RAY_PACKET_SIZE, intervalMax);
+                                node = offset + offsetFar3[axis];
+                                mask = farMask;
+                                continue;
+                            }
+
+                            if (farMask)
+                            {
+                                // push far node
+                                pushed.node = offset + offsetFar3[axis];
+                                pushed.mask = farMask;
+                                stackPos++;
+                            }
+
+                            node = offset + 3 - offsetFar3[axis];
+                            mask = nearMask;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0 && mask)
+                            {
+                                for (uint32 r = 0; r < count; ++r)
+                                {
+                                    if ((mask & (1 << r)) && intersectCallback(rays[r], objects[offset], maxDist[r], true))
+                                    {
+                                        hitMask |= 1 << r;
+                                        mask &= ~(1 << r);
+                                    }
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis > 2)
+                            return hitMask; // should not happen
+                        float clipLow = intBitsToFloat(tree[node + 1]);
+                        float clipHigh = intBitsToFloat(tree[node + 2]);
+                        uint32 boxMask = 0;
+                        for (uint32 r = 0; r < MAX_RAY_PACKET_SIZE; r += 4)
+                        {
+                            __m128 o = _mm_loadu_ps(&org[axis][r]);
+                            __m128 id = _mm_loadu_ps(&invDir[axis][r]);
+                            __m128 tLow = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(clipLow), o), id);
+                            __m128 tHigh = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(clipHigh), o), id);
+                            __m128 prevMin = _mm_loadu_ps(&intervalMin[r]);
+                            __m128 prevMax = _mm_loadu_ps(&intervalMax[r]);
+                            __m128 iMin = _mm_max_ps(_mm_min_ps(tLow, tHigh), prevMin);
+                            __m128 iMax = _mm_min_ps(_mm_max_ps(tLow, tHigh), prevMax);
+                            // a ray lying in a clip plane keeps its interval, as in intersectRay
+                            __m128 ordered = _mm_cmpord_ps(tLow, tHigh);
+                            iMin = _mm_or_ps(_mm_and_ps(ordered, iMin), _mm_andnot_ps(ordered, prevMin));
+                            iMax = _mm_or_ps(_mm_and_ps(ordered, iMax), _mm_andnot_ps(ordered, prevMax));
+                            _mm_storeu_ps(&intervalMin[r], iMin);
+                            _mm_storeu_ps(&intervalMax[r], iMax);
+                            boxMask |= uint32(_mm_movemask_ps(_mm_cmple_ps(iMin, iMax))) << r;
+                        }
+
+                        node = offset;
+                        mask &= boxMask;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return hitMask;
+                    // move back up the stack
+                    stackPos--;
+                    PacketStackNode const& popped = stack[stackPos];
+                    mask = popped.mask & ~hitMask;
+                    for (uint32 r = 0; r < count; ++r)
+                        if (maxDist[r] < popped.tnear[r])
+                            mask &= ~(1 << r);
+                    if (!mask)
+                        continue;
+                    node = popped.node;
+                    std::copy(popped.tnear, popped.tnear + MAX_RAY_PACKET_SIZE, intervalMin);
+                    std::copy(popped.tfar, popped.tfar + MAX_RAY_PACKET_SIZE, intervalMax);
+                    break;
+                } while (true);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -334,11 +553,12 @@ class TC_COMMON_API BIH
         }
 
         bool writeToFile(FILE* wf) const;
-        bool readFromFile(FILE* rf);
+        bool readFromFile(VMAP::VMapFileReader& reader);
 
     protected:
-        std::vector<uint32> tree;
-        std::vector<uint32> objects;
+        // used in place when read from a memory mapped file
+        VMAP::MappedArray<uint32> tree;
+        VMAP::MappedArray<uint32> objects;
         G3D::AABox bounds;
 
         struct buildData
@@ -355,6 +575,14 @@ class TC_COMMON_API BIH
             float tfar;
         };
 
+        struct PacketStackNode
+        {
+            uint32 node;
+            uint32 mask;
+            float tnear[MAX_RAY_PACKET_SIZE];
+            float tfar[MAX_RAY_PACKET_SIZE];
+        };
+
         class BuildStats
         {
             private:
@@ -22,6 +22,12 @@
 #include "ModelIgnoreFlags.h"
 #include "Optional.h"
 #include <string>
+#include <vector>
+
+namespace G3D
+{
+    class Vector3;
+}
 
 //===========================================================
 
@@ -85,6 +91,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            /**
+            line of sight of many segments at once, only segments still marked in visible are checked and blocked ones are cleared
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, std::size_t count, ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
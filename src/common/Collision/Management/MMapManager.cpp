@@ -26,6 +26,9 @@ namespace MMAP
     static char const* const MAP_FILE_NAME_FORMAT = "%smmaps/%03i.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "%smmaps/%03i%02i%02i.mmtile";
 
+    // every MMapData gets a new id so cached per thread queries of unloaded maps are never reused
+    static std::atomic<uint32> NextMMapDataId(1);
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -106,7 +109,7 @@ namespace MMAP
         TC_LOG_DEBUG("maps", "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, NextMMapDataId++);
 
         itr->second = mmap_data;
         return true;
@@ -117,21 +120,8 @@ namespace MMAP
         return uint32(x << 16 | y);
     }
 
-    bool MMapManager::loadMap(std::string const& basePath, uint32 mapId, int32 x, int32 y)
+    bool MMapManager::readTile(std::string const& basePath, uint32 mapId, int32 x, int32 y, MMapTileData& tile) const
     {
-        // make sure the mmap is loaded and ready to load tiles
-        if (!loadMapData(basePath, mapId))
-            return false;
-
-        // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
-        ASSERT(mmap->navMesh);
-
-        // check if we already have this tile loaded
-        uint32 packedGridPos = packTileID(x, y);
-        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
-            return false;
-
         // load this tile :: mmaps/MMMXXYY.mmtile
         std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath.c_str(), mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
@@ -186,18 +176,57 @@ namespace MMAP
         if (!result)
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            dtFree(data);
             fclose(file);
             return false;
         }
 
         fclose(file);
 
-        dtMeshHeader* header = (dtMeshHeader*)data;
+        if (tile.data)
+            dtFree(tile.data);
+
+        tile.data = data;
+        tile.size = fileHeader.size;
+        return true;
+    }
+
+    bool MMapManager::loadMap(std::string const& basePath, uint32 mapId, int32 x, int32 y, MMapTileData* readAhead /*= nullptr*/)
+    {
+        // make sure the mmap is loaded and ready to load tiles
+        if (!loadMapData(basePath, mapId))
+            return false;
+
+        // get this mmap data
+        MMapData* mmap = loadedMMaps[mapId];
+        ASSERT(mmap->navMesh);
+
+        // check if we already have this tile loaded
+        uint32 packedGridPos = packTileID(x, y);
+        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
+            return false;
+
+        MMapTileData tile;
+        if (readAhead)
+        {
+            // the read failed already, it was logged then
+            if (!readAhead->data)
+                return false;
+
+            std::swap(tile.data, readAhead->data);
+            std::swap(tile.size, readAhead->size);
+        }
+        else if (!readTile(basePath, mapId, x, y, tile))
+            return false;
+
+        dtMeshHeader* header = (dtMeshHeader*)tile.data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        std::unique_lock<std::shared_mutex> tileLock(mmap->tileLock);
+        if (dtStatusSucceed(mmap->navMesh->addTile(tile.data, tile.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
+            tile.data = nullptr;
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
@@ -206,33 +235,13 @@ namespace MMAP
         else
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
             return false;
         }
     }
 
-    bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId)
+    bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId)
     {
-        if (!loadMapData(basePath, mapId))
-            return false;
-
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) != mmap->navMeshQueries.end())
-            return true;
-
-        // allocate mesh query
-        dtNavMeshQuery* query = dtAllocNavMeshQuery();
-        ASSERT(query);
-        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-        {
-            dtFreeNavMeshQuery(query);
-            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-        mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-        return true;
+        return loadMapData(basePath, mapId);
     }
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
@@ -259,6 +268,7 @@ namespace MMAP
         }
 
         // unload, and mark as non loaded
+        std::unique_lock<std::shared_mutex> tileLock(mmap->tileLock);
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
         {
             // this is technically a memory leak
@@ -310,52 +320,62 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
-
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
+            return nullptr;
 
-        return true;
+        return itr->second->navMesh;
     }
 
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
-        return itr->second->navMesh;
+        MMapData* mmap = itr->second;
+
+        // last query used by this thread for every map, skips the lock for repeated lookups
+        struct CachedQuery
+        {
+            uint32 MMapDataId;
+            dtNavMeshQuery* Query;
+        };
+        thread_local std::unordered_map<uint32, CachedQuery> threadQueries;
+
+        CachedQuery& cached = threadQueries[mapId];
+        if (cached.MMapDataId == mmap->id)
+            return cached.Query;
+
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        dtNavMeshQuery*& query = mmap->navMeshQueries[std::this_thread::get_id()];
+        if (!query)
+        {
+            query = dtAllocNavMeshQuery();
+            ASSERT(query);
+            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+            {
+                dtFreeNavMeshQuery(query);
+                mmap->navMeshQueries.erase(std::this_thread::get_id());
+                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+                return nullptr;
+            }
+
+            TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+        }
+
+        cached = { mmap->id, query };
+        return query;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    std::shared_lock<std::shared_mutex> MMapManager::LockTiles(uint32 mapId) const
     {
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
-            return nullptr;
-
-        auto queryItr = itr->second->navMeshQueries.find(instanceId);
-        if (queryItr == itr->second->navMeshQueries.end())
-            return nullptr;
+            return std::shared_lock<std::shared_mutex>();
 
-        return queryItr->second;
+        return std::shared_lock<std::shared_mutex>(itr->second->tileLock);
     }
 }
@@ -21,7 +21,11 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -29,12 +33,12 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 dataId) : id(dataId), navMesh(mesh) { }
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
@@ -44,17 +48,36 @@ namespace MMAP
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        uint32 id;
+
+        // dtNavMeshQuery is not thread safe, every thread gets its own for each map it searches paths on
+        NavMeshQuerySet navMeshQueries;     // thread to query
+        std::mutex navMeshQueriesLock;
 
         dtNavMesh* navMesh;
 
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+
+        // held exclusively while tiles are added or removed, shared by threads searching off the map thread
+        std::shared_mutex tileLock;
     };
 
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    // contents of an mmtile file, read on any thread ahead of adding the tile to its navmesh
+    struct TC_COMMON_API MMapTileData
+    {
+        MMapTileData() : data(nullptr), size(0) { }
+        ~MMapTileData() { if (data) dtFree(data); }
+
+        MMapTileData(MMapTileData const&) = delete;
+        MMapTileData& operator=(MMapTileData const&) = delete;
+
+        unsigned char* data;
+        uint32 size;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class TC_COMMON_API MMapManager
@@ -64,16 +87,21 @@ namespace MMAP
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
-            bool loadMap(std::string const& basePath, uint32 mapId, int32 x, int32 y);
-            bool loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId);
+            // adds the tile to the navmesh, a tile read before by readTile is used instead of reading the file again
+            bool loadMap(std::string const& basePath, uint32 mapId, int32 x, int32 y, MMapTileData* readAhead = nullptr);
+            // only reads the tile file, thread safe
+            bool readTile(std::string const& basePath, uint32 mapId, int32 x, int32 y, MMapTileData& tile) const;
+            bool loadMapInstance(std::string const& basePath, uint32 mapId);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread and must not be passed to other threads
+            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // keeps tiles of the map from being added or removed while the lock is held, empty if the map is not loaded
+            std::shared_lock<std::shared_mutex> LockTiles(uint32 mapId) const;
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
@@ -50,6 +50,7 @@ namespace VMAP
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
         thread_safe_environment = true;
+        memoryMappedFiles = true;
     }
 
     VMapManager2::~VMapManager2()
@@ -124,7 +125,7 @@ namespace VMAP
         {
             std::string mapFileName = getMapFileName(mapId);
             StaticMapTree* newTree = new StaticMapTree(mapId, basePath);
-            LoadResult treeInitResult = newTree->InitMap(mapFileName);
+            LoadResult treeInitResult = newTree->InitMap(mapFileName, memoryMappedFiles);
             if (treeInitResult != LoadResult::Success)
             {
                 delete newTree;
@@ -181,6 +182,26 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, Vector3 const* starts, Vector3 const* ends, std::size_t count, ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> internalStarts(count);
+        std::vector<Vector3> internalEnds(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            internalStarts[i] = convertPositionToInternalRep(starts[i].x, starts[i].y, starts[i].z);
+            internalEnds[i] = convertPositionToInternalRep(ends[i].x, ends[i].y, ends[i].z);
+        }
+
+        instanceTree->second->isInLineOfSight(internalStarts.data(), internalEnds.data(), count, ignoreFlags, visible);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -322,7 +343,7 @@ namespace VMAP
         if (model == iLoadedModelFiles.end())
         {
             ManagedModel* worldmodel = new ManagedModel();
-            if (!worldmodel->getModel()->readFile(basepath + filename + ".vmo"))
+            if (!worldmodel->getModel()->readFile(basepath + filename + ".vmo", memoryMappedFiles))
             {
                 VMAP_ERROR_LOG("misc", "VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
                 delete worldmodel;
@@ -358,6 +379,26 @@ namespace VMAP
         }
     }
 
+    std::vector<std::string> VMapManager2::acquireTileModels(char const* basePath, unsigned int mapId, int x, int y)
+    {
+        std::vector<std::string> models;
+        if (!isMapLoadingEnabled())
+            return models;
+
+        // same path StaticMapTree acquires the models with
+        std::string modelPath = basePath;
+        if (!modelPath.empty() && modelPath.back() != '/' && modelPath.back() != '\\')
+            modelPath.push_back('/');
+
+        std::vector<ModelSpawn> spawns;
+        StaticMapTree::ReadMapTileSpawns(modelPath, mapId, x, y, this, spawns);
+        for (ModelSpawn const& spawn : spawns)
+            if (acquireModelInstance(modelPath, spawn.name, spawn.flags))
+                models.push_back(spawn.name);
+
+        return models;
+    }
+
     LoadResult VMapManager2::existsMap(char const* basePath, unsigned int mapId, int x, int y)
     {
         return StaticMapTree::CanLoadMap(std::string(basePath), mapId, x, y, this);
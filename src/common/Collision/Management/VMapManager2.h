@@ -70,6 +70,7 @@ namespace VMAP
             InstanceTreeMap iInstanceMapTrees;
             std::unordered_map<uint32, uint32> iParentMapData;
             bool thread_safe_environment;
+            bool memoryMappedFiles;
             // Mutex for iLoadedModelFiles
             std::mutex LoadedModelFilesLock;
 
@@ -87,6 +88,8 @@ namespace VMAP
             ~VMapManager2();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
+            // Model geometry and map trees are used in place from mapped files, shared by all processes on the host
+            void SetMemoryMappedFiles(bool enable) { memoryMappedFiles = enable; }
 
             LoadResult loadMap(char const* pBasePath, unsigned int mapId, int x, int y) override;
 
@@ -95,6 +98,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+            void isInLineOfSight(unsigned int mapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, std::size_t count, ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -109,6 +113,8 @@ namespace VMAP
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename, uint32 flags = 0);
             void releaseModelInstance(const std::string& filename);
+            // Loads the models spawned on a tile without adding the tile to its map, thread safe. The returned names must be released
+            std::vector<std::string> acquireTileModels(char const* basePath, unsigned int mapId, int x, int y);
 
             // what's the use of this? o.O
             virtual std::string getDirFileName(unsigned int mapId, int /*x*/, int /*y*/) const override
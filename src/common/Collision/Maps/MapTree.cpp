@@ -171,6 +171,53 @@ namespace VMAP
 
         return true;
     }
+    //=========================================================
+    void StaticMapTree::isInLineOfSight(Vector3 const* starts, Vector3 const* ends, std::size_t count, ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) const
+    {
+        // packets are traversed in the order of their first ray, keep segments of similar direction together
+        std::vector<std::pair<float, std::size_t>> order;
+        order.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!visible[i])
+                continue;
+
+            // same special cases as the single segment check
+            float dist = (ends[i] - starts[i]).magnitude();
+            if (dist == std::numeric_limits<float>::max() || !std::isfinite(dist))
+            {
+                visible[i] = false;
+                continue;
+            }
+
+            if (dist < 1e-10f)
+                continue;
+
+            order.emplace_back(std::atan2(ends[i].y - starts[i].y, ends[i].x - starts[i].x), i);
+        }
+
+        std::sort(order.begin(), order.end());
+
+        G3D::Ray rays[MAX_RAY_PACKET_SIZE];
+        float maxDist[MAX_RAY_PACKET_SIZE];
+        MapRayCallback intersectionCallBack(iTreeValues, ignoreFlags);
+        for (std::size_t first = 0; first < order.size(); first += MAX_RAY_PACKET_SIZE)
+        {
+            uint32 packetSize = uint32(std::min<std::size_t>(MAX_RAY_PACKET_SIZE, order.size() - first));
+            for (uint32 r = 0; r < packetSize; ++r)
+            {
+                std::size_t i = order[first + r].second;
+                maxDist[r] = (ends[i] - starts[i]).magnitude();
+                rays[r] = G3D::Ray::fromOriginAndDirection(starts[i], (ends[i] - starts[i]) / maxDist[r]);
+            }
+
+            uint32 hitMask = iTree.intersectRayPacket(rays, maxDist, packetSize, intersectionCallBack);
+            for (uint32 r = 0; r < packetSize; ++r)
+                if (hitMask & (1 << r))
+                    visible[order[first + r].second] = false;
+        }
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -304,20 +351,43 @@ namespace VMAP
 
     //=========================================================
 
-    LoadResult StaticMapTree::InitMap(std::string const& fname)
+    bool StaticMapTree::ReadMapTileSpawns(std::string const& basePath, uint32 mapID, uint32 tileX, uint32 tileY, VMapManager2* vm, std::vector<ModelSpawn>& spawns)
+    {
+        TileFileOpenResult fileResult = OpenMapTileFile(basePath, mapID, tileX, tileY, vm);
+        if (!fileResult.File)
+            return false;
+
+        char chunk[8];
+        uint32 numSpawns = 0;
+        bool result = readChunk(fileResult.File, chunk, VMAP_MAGIC, 8) && fread(&numSpawns, sizeof(uint32), 1, fileResult.File) == 1;
+        for (uint32 i = 0; i < numSpawns && result; ++i)
+        {
+            ModelSpawn spawn;
+            result = ModelSpawn::readFromFile(fileResult.File, spawn);
+            if (result)
+                spawns.push_back(std::move(spawn));
+        }
+
+        fclose(fileResult.File);
+        return result;
+    }
+
+    //=========================================================
+
+    LoadResult StaticMapTree::InitMap(std::string const& fname, bool memoryMapped)
     {
         TC_LOG_DEBUG("maps", "StaticMapTree::InitMap() : initializing StaticMapTree '%s'", fname.c_str());
         std::string fullname = iBasePath + fname;
-        FILE* rf = fopen(fullname.c_str(), "rb");
-        if (!rf)
+        std::unique_ptr<VMapFileImage> image = std::make_unique<VMapFileImage>();
+        if (!image->Open(fullname, memoryMapped))
             return LoadResult::FileNotFound;
 
+        VMapFileReader reader(*image);
         LoadResult result = LoadResult::Success;
-        char chunk[8];
 
-        if (readChunk(rf, chunk, VMAP_MAGIC, 8) &&
-            readChunk(rf, chunk, "NODE", 4) &&
-            iTree.readFromFile(rf))
+        if (reader.ReadChunk(VMAP_MAGIC, 8) &&
+            reader.ReadChunk("NODE", 4) &&
+            iTree.readFromFile(reader))
         {
             iNTreeValues = iTree.primCount();
             iTreeValues = new ModelInstance[iNTreeValues];
@@ -326,22 +396,22 @@ namespace VMAP
 
         if (result == LoadResult::Success)
         {
-            result = readChunk(rf, chunk, "SIDX", 4) ? LoadResult::Success : LoadResult::ReadFromFileFailed;
+            result = reader.ReadChunk("SIDX", 4) ? LoadResult::Success : LoadResult::ReadFromFileFailed;
             uint32 spawnIndicesSize = 0;
             uint32 spawnId;
             uint32 spawnIndex;
-            if (result == LoadResult::Success && fread(&spawnIndicesSize, sizeof(uint32), 1, rf) != 1)
+            if (result == LoadResult::Success && !reader.Read(spawnIndicesSize))
                 result = LoadResult::ReadFromFileFailed;
             for (uint32 i = 0; i < spawnIndicesSize && result == LoadResult::Success; ++i)
             {
-                if (fread(&spawnId, sizeof(uint32), 1, rf) == 1 && fread(&spawnIndex, sizeof(uint32), 1, rf) == 1)
+                if (reader.Read(spawnId) && reader.Read(spawnIndex))
                     iSpawnIndices[spawnId] = spawnIndex;
                 else
                     result = LoadResult::ReadFromFileFailed;
             }
         }
 
-        fclose(rf);
+        iTreeFile = std::move(image);
         return result;
     }
 
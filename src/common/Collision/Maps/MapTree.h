@@ -20,12 +20,14 @@
 
 #include "Define.h"
 #include "BoundingIntervalHierarchy.h"
+#include <memory>
 #include <unordered_map>
 
 
 namespace VMAP
 {
     class ModelInstance;
+    class ModelSpawn;
     class GroupModel;
     class VMapManager2;
     enum class LoadResult : uint8;
@@ -52,6 +54,7 @@ namespace VMAP
         typedef std::unordered_map<uint32, uint32> loadedSpawnMap;
         private:
             uint32 iMapID;
+            std::unique_ptr<VMapFileImage> iTreeFile; // iTree is used in place from it
             BIH iTree;
             ModelInstance* iTreeValues; // the tree entries
             uint32 iNTreeValues;
@@ -82,17 +85,21 @@ namespace VMAP
             static uint32 packTileID(uint32 tileX, uint32 tileY) { return tileX<<16 | tileY; }
             static void unpackTileID(uint32 ID, uint32 &tileX, uint32 &tileY) { tileX = ID >> 16; tileY = ID & 0xFF; }
             static LoadResult CanLoadMap(const std::string &basePath, uint32 mapID, uint32 tileX, uint32 tileY, VMapManager2* vm);
+            // reads the model spawns of a tile file without changing any tree, false if there is no readable tile file
+            static bool ReadMapTileSpawns(std::string const& basePath, uint32 mapID, uint32 tileX, uint32 tileY, VMapManager2* vm, std::vector<ModelSpawn>& spawns);
 
             StaticMapTree(uint32 mapID, const std::string &basePath);
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
+            // checks the segments still marked visible in packets, blocked ones are cleared
+            void isInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, std::size_t count, ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
             bool GetLocationInfo(const G3D::Vector3 &pos, LocationInfo &info) const;
 
-            LoadResult InitMap(std::string const& fname);
+            LoadResult InitMap(std::string const& fname, bool memoryMapped = true);
             void UnloadMap(VMapManager2* vm);
             LoadResult LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
             void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
@@ -23,8 +23,10 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include "BoundingIntervalHierarchy.h"
+#include "VMapFile.h"
 
 #include "Define.h"
+#include <memory>
 
 namespace VMAP
 {
@@ -58,7 +60,7 @@ namespace VMAP
             uint8 *GetFlagsStorage() { return iFlags; }
             uint32 GetFileSize();
             bool writeToFile(FILE* wf);
-            static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
+            static bool readFromFile(VMapFileReader& reader, WmoLiquid* &liquid);
             void getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const;
         private:
             WmoLiquid() : iTilesX(0), iTilesY(0), iCorner(), iType(0), iHeight(nullptr), iFlags(nullptr) { }
@@ -80,7 +82,7 @@ namespace VMAP
                         iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(nullptr) { }
             ~GroupModel() { delete iLiquid; }
 
-            //! pass mesh data to object and create BIH. Passed vectors get get swapped with old geometry!
+            //! pass mesh data to object and create BIH. Passed vectors are moved into the model!
             void setMeshData(std::vector<G3D::Vector3> &vert, std::vector<MeshTriangle> &tri);
             void setLiquidData(WmoLiquid*& liquid) { iLiquid = liquid; liquid = nullptr; }
             bool IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const;
@@ -88,7 +90,7 @@ namespace VMAP
             bool GetLiquidLevel(const G3D::Vector3 &pos, float &liqHeight) const;
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
-            bool readFromFile(FILE* rf);
+            bool readFromFile(VMapFileReader& reader);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -97,8 +99,9 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
-            std::vector<G3D::Vector3> vertices;
-            std::vector<MeshTriangle> triangles;
+            // used in place when read from a memory mapped file
+            MappedArray<G3D::Vector3> vertices;
+            MappedArray<MeshTriangle> triangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
     };
@@ -116,7 +119,7 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, GroupLocationInfo& info) const;
             bool writeFile(const std::string &filename);
-            bool readFile(const std::string &filename);
+            bool readFile(const std::string &filename, bool memoryMapped = true);
             void getGroupModels(std::vector<GroupModel>& outGroupModels);
             std::string const& GetName() const { return name; }
             void SetName(std::string newName) { name = std::move(newName); }
@@ -126,6 +129,7 @@ namespace VMAP
             std::vector<GroupModel> groupModels;
             BIH groupTree;
             std::string name;
+            std::unique_ptr<VMapFileImage> fileImage; // geometry and trees of a read model point into it
     };
 } // namespace VMAP
 
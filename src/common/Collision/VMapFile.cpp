@@ -0,0 +1,78 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "VMapFile.h"
+#include "MappedFile.h"
+#include <cstdio>
+
+namespace VMAP
+{
+    VMapFileImage::VMapFileImage() : _data(nullptr), _size(0) { }
+
+    VMapFileImage::~VMapFileImage() = default;
+
+    bool VMapFileImage::Open(std::string const& path, bool memoryMapped)
+    {
+        if (memoryMapped)
+        {
+            std::unique_ptr<Trinity::MappedFile> mappedFile = std::make_unique<Trinity::MappedFile>();
+            if (mappedFile->Open(path))
+            {
+                _data = mappedFile->GetData();
+                _size = mappedFile->GetSize();
+                _mappedFile = std::move(mappedFile);
+                return true;
+            }
+        }
+
+        // mapping failed or is disabled, read the whole file at once
+        FILE* rf = fopen(path.c_str(), "rb");
+        if (!rf)
+            return false;
+
+        long size = -1;
+        if (fseek(rf, 0, SEEK_END) == 0)
+            size = ftell(rf);
+
+        if (size <= 0 || fseek(rf, 0, SEEK_SET) != 0)
+        {
+            fclose(rf);
+            return false;
+        }
+
+        std::unique_ptr<uint8[]> buffer = std::make_unique<uint8[]>(size);
+        bool result = fread(buffer.get(), size, 1, rf) == 1;
+        fclose(rf);
+        if (!result)
+            return false;
+
+        _buffer = std::move(buffer);
+        _data = _buffer.get();
+        _size = std::size_t(size);
+        return true;
+    }
+
+    bool VMapFileReader::ReadChunk(char const* compare, uint32 len)
+    {
+        if (len > _size - _offset)
+            return false;
+
+        bool result = memcmp(_data + _offset, compare, len) == 0;
+        _offset += len;
+        return result;
+    }
+}
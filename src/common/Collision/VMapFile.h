@@ -0,0 +1,179 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VMapFile_h__
+#define VMapFile_h__
+
+#include "Define.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Trinity
+{
+    class MappedFile;
+}
+
+namespace VMAP
+{
+    /**
+    * Contiguous array that either owns its values or uses them in place from a loaded vmap file.
+    * Copies of an array in a file point into the same file, which must outlive them.
+    */
+    template<typename T>
+    class MappedArray
+    {
+    public:
+        MappedArray() : _data(nullptr), _size(0), _mapped(false) { }
+        MappedArray(MappedArray const& other) : _data(nullptr), _size(0), _mapped(false) { *this = other; }
+        MappedArray(MappedArray&& other) noexcept : _data(nullptr), _size(0), _mapped(false) { *this = std::move(other); }
+
+        MappedArray& operator=(MappedArray const& right)
+        {
+            if (this == &right)
+                return *this;
+
+            if (right._mapped)
+                Map(right._data, right._size);
+            else
+                Assign(std::vector<T>(right._storage));
+            return *this;
+        }
+
+        MappedArray& operator=(MappedArray&& right) noexcept
+        {
+            if (this == &right)
+                return *this;
+
+            _storage = std::move(right._storage);
+            _mapped = right._mapped;
+            _data = _mapped ? right._data : _storage.data();
+            _size = right._size;
+            right.Assign(std::vector<T>());
+            return *this;
+        }
+
+        void Assign(std::vector<T>&& values)
+        {
+            _storage = std::move(values);
+            _data = _storage.data();
+            _size = _storage.size();
+            _mapped = false;
+        }
+
+        void Map(T const* values, std::size_t count)
+        {
+            std::vector<T>().swap(_storage);
+            _data = values;
+            _size = count;
+            _mapped = true;
+        }
+
+        bool IsMapped() const { return _mapped; }
+
+        T const* data() const { return _data; }
+        std::size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        T const* begin() const { return _data; }
+        T const* end() const { return _data + _size; }
+        T const& operator[](std::size_t index) const { return _data[index]; }
+
+    private:
+        std::vector<T> _storage;
+        T const* _data;
+        std::size_t _size;
+        bool _mapped;
+    };
+
+    /// Whole vmap file, memory mapped (copy-on-write, shared with other processes mapping it) or read into one buffer
+    class TC_COMMON_API VMapFileImage
+    {
+    public:
+        VMapFileImage();
+        ~VMapFileImage();
+
+        VMapFileImage(VMapFileImage const&) = delete;
+        VMapFileImage& operator=(VMapFileImage const&) = delete;
+
+        bool Open(std::string const& path, bool memoryMapped);
+
+        uint8 const* GetData() const { return _data; }
+        std::size_t GetSize() const { return _size; }
+
+    private:
+        std::unique_ptr<Trinity::MappedFile> _mappedFile;
+        std::unique_ptr<uint8[]> _buffer;
+        uint8 const* _data;
+        std::size_t _size;
+    };
+
+    /// Sequential, bounds checked reads from a file image, arrays are used in place whenever they are aligned
+    class TC_COMMON_API VMapFileReader
+    {
+    public:
+        explicit VMapFileReader(VMapFileImage const& image) : _data(image.GetData()), _size(image.GetSize()), _offset(0) { }
+
+        bool ReadChunk(char const* compare, uint32 len);
+
+        template<typename T>
+        bool Read(T& value) { return Read(&value, 1); }
+
+        template<typename T>
+        bool Read(T* values, std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read from vmap files");
+            if (count > (_size - _offset) / sizeof(T))
+                return false;
+
+            memcpy(values, _data + _offset, count * sizeof(T));
+            _offset += count * sizeof(T);
+            return true;
+        }
+
+        template<typename T>
+        bool Map(MappedArray<T>& array, std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain data can be mapped from vmap files");
+            if (count > (_size - _offset) / sizeof(T))
+                return false;
+
+            T const* values = reinterpret_cast<T const*>(_data + _offset);
+            _offset += count * sizeof(T);
+
+            // arrays behind odd sized data (liquid flags) are copied
+            if (reinterpret_cast<uintptr_t>(values) % alignof(T))
+            {
+                std::vector<T> copy(count);
+                memcpy(copy.data(), values, count * sizeof(T));
+                array.Assign(std::move(copy));
+            }
+            else
+                array.Map(values, count);
+
+            return true;
+        }
+
+    private:
+        uint8 const* _data;
+        std::size_t _size;
+        std::size_t _offset;
+    };
+}
+
+#endif // VMapFile_h__
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
@@ -316,3 +317,87 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 
     return stringPool;
 }
+
+bool DBCFileLoader::ReadHeader(unsigned char const* fileData, size_t fileSize, uint32& records, uint32& fields, uint32& rowSize, uint32& strings)
+{
+    uint32 header[5];
+    if (fileSize < sizeof(header))
+        return false;
+
+    memcpy(header, fileData, sizeof(header));
+    for (uint32& value : header)
+        EndianConvert(value);
+
+    if (header[0] != 0x43424457)                             //'WDBC'
+        return false;
+
+    records = header[1];
+    fields = header[2];
+    rowSize = header[3];
+    strings = header[4];
+    return uint64(records) * rowSize + strings <= fileSize - sizeof(header);
+}
+
+bool DBCFileLoader::IsInPlaceFormat(char const* format)
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    // file data needs EndianConvert on every field
+    (void)format;
+    return false;
+#else
+    if (!*format)
+        return false;
+
+    for (uint32 x = 0; format[x]; ++x)
+        if (format[x] != FT_IND && format[x] != FT_INT && format[x] != FT_FLOAT)
+            return false;
+
+    return true;
+#endif
+}
+
+bool DBCFileLoader::HasStringFields(char const* format)
+{
+    return strchr(format, FT_STRING) != nullptr;
+}
+
+char** DBCFileLoader::IndexInPlace(unsigned char* fileData, size_t fileSize, char const* format, uint32& records)
+{
+    if (!IsInPlaceFormat(format))
+        return nullptr;
+
+    uint32 recordCount, fieldCount, recordSize, stringSize;
+    if (!ReadHeader(fileData, fileSize, recordCount, fieldCount, recordSize, stringSize))
+        return nullptr;
+
+    int32 indexPos;
+    if (strlen(format) != fieldCount || GetFormatRecordSize(format, &indexPos) != recordSize)
+        return nullptr;
+
+    unsigned char* recordData = fileData + 5 * sizeof(uint32);
+    char** indexTable;
+    if (indexPos >= 0)
+    {
+        uint32 maxi = 0;
+        for (uint32 y = 0; y < recordCount; ++y)
+            maxi = std::max(maxi, *reinterpret_cast<uint32 const*>(recordData + y * recordSize + indexPos * sizeof(uint32)));
+
+        records = maxi + 1;
+        indexTable = new char*[records];
+        memset(indexTable, 0, records * sizeof(char*));
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(recordData + y * recordSize);
+            indexTable[*reinterpret_cast<uint32 const*>(record + indexPos * sizeof(uint32))] = record;
+        }
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new char*[recordCount];
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[y] = reinterpret_cast<char*>(recordData + y * recordSize);
+    }
+
+    return indexTable;
+}
@@ -95,6 +95,14 @@ class TC_COMMON_API DBCFileLoader
         char* AutoProduceStrings(char const* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(char const* format, int32* index_pos = nullptr);
 
+        /// Reads the header of a DBC file image, returns false if it is not a complete WDBC file
+        static bool ReadHeader(unsigned char const* fileData, size_t fileSize, uint32& records, uint32& fields, uint32& rowSize, uint32& strings);
+        /// True for formats whose entry struct is byte for byte the file record - 4 byte numeric fields only, nothing skipped
+        static bool IsInPlaceFormat(char const* format);
+        static bool HasStringFields(char const* format);
+        /// Builds an index table pointing straight into the records of a DBC file image, nullptr if the image does not match the format
+        static char** IndexInPlace(unsigned char* fileData, size_t fileSize, char const* format, uint32& records);
+
     private:
         uint32 recordSize;
         uint32 recordCount;
@@ -69,6 +69,12 @@ public:
         return true;
     }
 
+    /// Consumer side only, a node that is still being linked by a producer is not seen
+    bool Empty() const
+    {
+        return _tail.load(std::memory_order_relaxed)->Next.load(std::memory_order_acquire) == nullptr;
+    }
+
 private:
     struct Node
     {
@@ -158,6 +164,12 @@ public:
         return false;
     }
 
+    /// Consumer side only, a node that is still being linked by a producer is not seen
+    bool Empty() const
+    {
+        return _tail.load(std::memory_order_relaxed) == _dummyPtr && (_dummyPtr->*IntrusiveLink).load(std::memory_order_acquire) == nullptr;
+    }
+
 private:
     alignas(T) std::array<std::byte, sizeof(T)> _dummy;
     T* _dummyPtr;
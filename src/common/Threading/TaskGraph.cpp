@@ -0,0 +1,143 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace Trinity
+{
+TaskGraph::TaskGraph() : _finished(0) { }
+
+TaskGraph::TaskId TaskGraph::AddTask(std::string name, std::function<void()> work, std::vector<TaskId> dependencies /*= { }*/)
+{
+    TaskId id = _tasks.size();
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Task %s depends on a task that was not added before it", name.c_str());
+        _tasks[dependency].Dependents.push_back(id);
+    }
+
+    Task& task = _tasks.emplace_back();
+    task.Name = std::move(name);
+    task.Work = std::move(work);
+    task.Dependencies = std::move(dependencies);
+    task.PendingDependencies = 0;
+    return id;
+}
+
+void TaskGraph::Run(std::size_t threads)
+{
+    for (Task& task : _tasks)
+        task.PendingDependencies = task.Dependencies.size();
+
+    _start = std::chrono::steady_clock::now();
+    _finished = 0;
+
+    if (threads <= 1 || _tasks.size() <= 1)
+    {
+        for (TaskId id = 0; id < _tasks.size(); ++id)
+            Execute(id, nullptr);
+    }
+    else
+    {
+        // collect the roots first, posted tasks start changing the pending counters right away
+        std::vector<TaskId> roots;
+        for (TaskId id = 0; id < _tasks.size(); ++id)
+            if (!_tasks[id].PendingDependencies)
+                roots.push_back(id);
+
+        ThreadPool pool(threads);
+        for (TaskId id : roots)
+            pool.PostWork([this, id, &pool]() { Execute(id, &pool); });
+
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _finishedCondition.wait(lock, [this]() { return _finished == _tasks.size(); });
+        }
+
+        pool.Join();
+    }
+
+    _end = std::chrono::steady_clock::now();
+}
+
+void TaskGraph::Execute(TaskId id, ThreadPool* pool)
+{
+    Task& task = _tasks[id];
+    task.Start = std::chrono::steady_clock::now();
+    task.Work();
+    task.End = std::chrono::steady_clock::now();
+
+    std::vector<TaskId> ready;
+    bool allFinished;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (TaskId dependent : task.Dependents)
+            if (!--_tasks[dependent].PendingDependencies && pool)
+                ready.push_back(dependent);
+
+        allFinished = ++_finished == _tasks.size();
+    }
+
+    for (TaskId dependent : ready)
+        pool->PostWork([this, dependent, pool]() { Execute(dependent, pool); });
+
+    if (allFinished)
+        _finishedCondition.notify_all();
+}
+
+Milliseconds TaskGraph::GetTaskStart(TaskId task) const
+{
+    return std::chrono::duration_cast<Milliseconds>(_tasks[task].Start - _start);
+}
+
+Milliseconds TaskGraph::GetTaskDuration(TaskId task) const
+{
+    return std::chrono::duration_cast<Milliseconds>(_tasks[task].End - _tasks[task].Start);
+}
+
+Milliseconds TaskGraph::GetTotalDuration() const
+{
+    return std::chrono::duration_cast<Milliseconds>(_end - _start);
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::GetCriticalPath() const
+{
+    std::vector<TaskId> path;
+    if (_tasks.empty())
+        return path;
+
+    auto finishedLater = [this](TaskId left, TaskId right) { return _tasks[left].End < _tasks[right].End; };
+
+    TaskId current = 0;
+    for (TaskId id = 1; id < _tasks.size(); ++id)
+        if (finishedLater(current, id))
+            current = id;
+
+    path.push_back(current);
+    while (!_tasks[current].Dependencies.empty())
+    {
+        current = *std::max_element(_tasks[current].Dependencies.begin(), _tasks[current].Dependencies.end(), finishedLater);
+        path.push_back(current);
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TaskGraph_h__
+#define TaskGraph_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+class ThreadPool;
+
+// Set of named tasks with prerequisites. Every task runs once all of its dependencies
+// finished, tasks that do not depend on each other run concurrently.
+// Dependencies can only refer to tasks added before, so the graph is always acyclic
+// and running the tasks in the order they were added is a valid schedule.
+class TC_COMMON_API TaskGraph
+{
+public:
+    typedef std::size_t TaskId;
+
+    TaskGraph();
+    TaskGraph(TaskGraph const&) = delete;
+    TaskGraph& operator=(TaskGraph const&) = delete;
+
+    TaskId AddTask(std::string name, std::function<void()> work, std::vector<TaskId> dependencies = { });
+
+    // Runs all tasks and blocks until they are finished, 1 thread runs them in order on the calling thread
+    void Run(std::size_t threads);
+
+    std::size_t GetTaskCount() const { return _tasks.size(); }
+    std::string const& GetTaskName(TaskId task) const { return _tasks[task].Name; }
+
+    // Timings of the last Run, relative to its start
+    Milliseconds GetTaskStart(TaskId task) const;
+    Milliseconds GetTaskDuration(TaskId task) const;
+    Milliseconds GetTotalDuration() const;
+
+    // Chain of dependencies that determined when the last task finished, first task first
+    std::vector<TaskId> GetCriticalPath() const;
+
+private:
+    struct Task
+    {
+        std::string Name;
+        std::function<void()> Work;
+        std::vector<TaskId> Dependencies;
+        std::vector<TaskId> Dependents;
+        std::size_t PendingDependencies;
+        std::chrono::steady_clock::time_point Start;
+        std::chrono::steady_clock::time_point End;
+    };
+
+    void Execute(TaskId task, ThreadPool* pool);
+
+    std::vector<Task> _tasks;
+    std::chrono::steady_clock::time_point _start;
+    std::chrono::steady_clock::time_point _end;
+
+    std::mutex _lock;
+    std::condition_variable _finishedCondition;
+    std::size_t _finished;
+};
+}
+
+#endif // TaskGraph_h__
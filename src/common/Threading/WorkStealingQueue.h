@@ -0,0 +1,186 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WorkStealingQueue_h__
+#define WorkStealingQueue_h__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace Trinity
+{
+// Set of per-worker deques. Every worker takes work from the front of its own deque
+// and, once that runs dry, steals from the back of the other workers' deques.
+template<typename T>
+class WorkStealingQueue
+{
+    struct Slot
+    {
+        std::mutex Lock;
+        std::deque<T> Queue;
+    };
+
+public:
+    explicit WorkStealingQueue(std::size_t workers) : _size(0), _shutdown(false)
+    {
+        _slots.reserve(std::max<std::size_t>(workers, 1));
+        for (std::size_t i = 0; i < std::max<std::size_t>(workers, 1); ++i)
+            _slots.push_back(std::make_unique<Slot>());
+    }
+
+    WorkStealingQueue(WorkStealingQueue const&) = delete;
+    WorkStealingQueue& operator=(WorkStealingQueue const&) = delete;
+
+    std::size_t GetWorkerCount() const { return _slots.size(); }
+
+    void Push(std::size_t worker, T value)
+    {
+        Slot& slot = *_slots[worker % _slots.size()];
+        {
+            std::lock_guard<std::mutex> lock(slot.Lock);
+            slot.Queue.push_back(std::move(value));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_waitLock);
+            ++_size;
+        }
+
+        _condition.notify_one();
+    }
+
+    // Longest-processing-time-first dispatch: items are sorted by descending cost and each one is
+    // appended to the worker with the least total cost assigned so far. Every deque therefore holds
+    // its most expensive work at the front and the cheap leftovers - the ones worth stealing - at the back.
+    template<typename CostFn>
+    void Distribute(std::vector<T>& items, CostFn&& cost)
+    {
+        using CostType = std::decay_t<decltype(cost(items.front()))>;
+
+        std::stable_sort(items.begin(), items.end(), [&cost](T const& left, T const& right)
+        {
+            return cost(left) > cost(right);
+        });
+
+        std::vector<CostType> load(_slots.size(), CostType());
+        for (T& item : items)
+        {
+            std::size_t worker = std::distance(load.begin(), std::min_element(load.begin(), load.end()));
+            load[worker] += cost(item);
+            Push(worker, std::move(item));
+        }
+
+        items.clear();
+    }
+
+    bool Pop(std::size_t worker, T& value)
+    {
+        std::size_t const count = _slots.size();
+        worker %= count;
+
+        {
+            Slot& own = *_slots[worker];
+            std::lock_guard<std::mutex> lock(own.Lock);
+            if (!own.Queue.empty())
+            {
+                value = std::move(own.Queue.front());
+                own.Queue.pop_front();
+                --_size;
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            Slot& victim = *_slots[(worker + i) % count];
+            std::lock_guard<std::mutex> lock(victim.Lock);
+            if (!victim.Queue.empty())
+            {
+                value = std::move(victim.Queue.back());
+                victim.Queue.pop_back();
+                --_size;
+                ++_steals;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Blocks until work is available for the worker or the queue is cancelled, returns false on cancellation
+    bool WaitAndPop(std::size_t worker, T& value)
+    {
+        while (!_shutdown)
+        {
+            if (Pop(worker, value))
+                return true;
+
+            std::unique_lock<std::mutex> lock(_waitLock);
+            while (_size == 0 && !_shutdown)
+                _condition.wait(lock);
+        }
+
+        return false;
+    }
+
+    void Cancel()
+    {
+        for (std::unique_ptr<Slot>& slot : _slots)
+        {
+            std::lock_guard<std::mutex> lock(slot->Lock);
+            for (T& value : slot->Queue)
+                DeleteQueuedObject(value);
+
+            slot->Queue.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_waitLock);
+            _size = 0;
+            _shutdown = true;
+        }
+
+        _condition.notify_all();
+    }
+
+    // Number of items that were taken from another worker's deque since the last call
+    std::size_t ResetStealCount() { return _steals.exchange(0); }
+
+private:
+    template<typename E = T>
+    typename std::enable_if<std::is_pointer<E>::value>::type DeleteQueuedObject(E& obj) { delete obj; }
+
+    template<typename E = T>
+    typename std::enable_if<!std::is_pointer<E>::value>::type DeleteQueuedObject(E const& /*obj*/) { }
+
+    std::vector<std::unique_ptr<Slot>> _slots;
+    std::mutex _waitLock;
+    std::condition_variable _condition;
+    std::atomic<std::size_t> _size;
+    std::atomic<std::size_t> _steals{ 0 };
+    std::atomic<bool> _shutdown;
+};
+}
+
+#endif // WorkStealingQueue_h__
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferPool.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+std::size_t constexpr ThreadCacheLimit = 32;                    // buffers per size class cached by a single thread
+std::size_t constexpr TransferBatchSize = 16;                   // buffers moved between a thread cache and the shared pool at once
+uint64 constexpr SharedPoolByteLimit = 64 * 1024 * 1024;
+
+typedef std::array<std::vector<std::vector<uint8>>, Trinity::BufferPool::SizeClassCount> SizeClassLists;
+
+std::atomic<uint64> Hits(0);
+std::atomic<uint64> Misses(0);
+std::atomic<uint64> ResidentBytes(0);
+
+struct SharedPool
+{
+    std::mutex Lock;
+    SizeClassLists Buffers;
+    uint64 Bytes = 0;
+};
+
+// never destroyed, buffers may still be released by static objects destroyed at exit
+SharedPool& GetSharedPool()
+{
+    static SharedPool* pool = new SharedPool();
+    return *pool;
+}
+
+void TransferToSharedPool(std::vector<std::vector<uint8>>& buffers, std::size_t sizeClass, std::size_t count)
+{
+    SharedPool& pool = GetSharedPool();
+    std::lock_guard<std::mutex> lock(pool.Lock);
+    for (std::size_t i = 0; i < count && !buffers.empty(); ++i)
+    {
+        std::vector<uint8> storage = std::move(buffers.back());
+        buffers.pop_back();
+        if (pool.Bytes + storage.capacity() > SharedPoolByteLimit)
+        {
+            ResidentBytes -= storage.capacity();
+            continue;
+        }
+
+        pool.Bytes += storage.capacity();
+        pool.Buffers[sizeClass].push_back(std::move(storage));
+    }
+}
+
+void TransferFromSharedPool(std::vector<std::vector<uint8>>& buffers, std::size_t sizeClass)
+{
+    SharedPool& pool = GetSharedPool();
+    std::lock_guard<std::mutex> lock(pool.Lock);
+    std::vector<std::vector<uint8>>& shared = pool.Buffers[sizeClass];
+    for (std::size_t i = 0; i < TransferBatchSize && !shared.empty(); ++i)
+    {
+        pool.Bytes -= shared.back().capacity();
+        buffers.push_back(std::move(shared.back()));
+        shared.pop_back();
+    }
+}
+
+thread_local bool ThreadCacheDestroyed = false;
+
+struct ThreadCache
+{
+    ThreadCache()
+    {
+        for (std::vector<std::vector<uint8>>& buffers : Buffers)
+            buffers.reserve(ThreadCacheLimit + 1);
+    }
+
+    ~ThreadCache()
+    {
+        ThreadCacheDestroyed = true;
+        for (std::size_t i = 0; i < Buffers.size(); ++i)
+            TransferToSharedPool(Buffers[i], i, Buffers[i].size());
+    }
+
+    SizeClassLists Buffers;
+};
+
+thread_local ThreadCache Cache;
+
+std::size_t GetAcquireSizeClass(std::size_t size)
+{
+    std::size_t i = 0;
+    while (i < Trinity::BufferPool::SizeClassCount && Trinity::BufferPool::SizeClasses[i] < size)
+        ++i;
+
+    return i;
+}
+
+std::size_t GetReleaseSizeClass(std::size_t capacity)
+{
+    // buffers that grew way past the largest class are not worth keeping around
+    if (capacity < Trinity::BufferPool::SizeClasses[0] || capacity > 2 * Trinity::BufferPool::SizeClasses[Trinity::BufferPool::SizeClassCount - 1])
+        return Trinity::BufferPool::SizeClassCount;
+
+    std::size_t i = Trinity::BufferPool::SizeClassCount - 1;
+    while (Trinity::BufferPool::SizeClasses[i] > capacity)
+        --i;
+
+    return i;
+}
+}
+
+std::vector<uint8> Trinity::BufferPool::Acquire(std::size_t size)
+{
+    std::vector<uint8> storage;
+    if (!size)
+        return storage;
+
+    std::size_t sizeClass = GetAcquireSizeClass(size);
+    if (sizeClass < SizeClassCount && !ThreadCacheDestroyed)
+    {
+        std::vector<std::vector<uint8>>& buffers = Cache.Buffers[sizeClass];
+        if (buffers.empty())
+            TransferFromSharedPool(buffers, sizeClass);
+
+        if (!buffers.empty())
+        {
+            storage = std::move(buffers.back());
+            buffers.pop_back();
+            ResidentBytes.fetch_sub(storage.capacity(), std::memory_order_relaxed);
+            Hits.fetch_add(1, std::memory_order_relaxed);
+            return storage;
+        }
+    }
+
+    Misses.fetch_add(1, std::memory_order_relaxed);
+    storage.reserve(sizeClass < SizeClassCount ? SizeClasses[sizeClass] : size);
+    return storage;
+}
+
+void Trinity::BufferPool::Release(std::vector<uint8>&& storage)
+{
+    std::size_t sizeClass = GetReleaseSizeClass(storage.capacity());
+    if (sizeClass == SizeClassCount || ThreadCacheDestroyed)
+        return;
+
+    std::vector<std::vector<uint8>>& buffers = Cache.Buffers[sizeClass];
+    ResidentBytes.fetch_add(storage.capacity(), std::memory_order_relaxed);
+    storage.clear();
+    buffers.push_back(std::move(storage));
+
+    if (buffers.size() > ThreadCacheLimit)
+        TransferToSharedPool(buffers, sizeClass, TransferBatchSize);
+}
+
+Trinity::BufferPool::Statistics Trinity::BufferPool::ResetStatistics()
+{
+    Statistics statistics;
+    statistics.Hits = Hits.exchange(0);
+    statistics.Misses = Misses.exchange(0);
+    statistics.ResidentBytes = ResidentBytes.load();
+    return statistics;
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BufferPool_h__
+#define BufferPool_h__
+
+#include "Define.h"
+#include <vector>
+
+namespace Trinity
+{
+/**
+* Size-classed pool of byte vectors backing MessageBuffer and ByteBuffer storage.
+* Every thread keeps a small cache per size class; buffers freed on one thread (network threads
+* releasing written packets) overflow into a shared pool that threads building packets refill from.
+*/
+class TC_COMMON_API BufferPool
+{
+public:
+    static constexpr std::size_t SizeClasses[] = { 256, 1024, 4096, 16384, 65536 };
+    static constexpr std::size_t SizeClassCount = sizeof(SizeClasses) / sizeof(SizeClasses[0]);
+
+    struct Statistics
+    {
+        uint64 Hits = 0;            // acquires served from a pool
+        uint64 Misses = 0;          // acquires that had to allocate
+        uint64 ResidentBytes = 0;   // capacity of all buffers currently held by the pools
+    };
+
+    /// Returns an empty vector with capacity for at least size bytes
+    static std::vector<uint8> Acquire(std::size_t size);
+
+    /// Returns storage of a destroyed buffer to the pool, storage that fits no size class is freed
+    static void Release(std::vector<uint8>&& storage);
+
+    /// Hits and misses are counted since the last call
+    static Statistics ResetStatistics();
+};
+}
+
+#endif // BufferPool_h__
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MappedFile_h__
+#define MappedFile_h__
+
+#include "Define.h"
+#include <string>
+
+namespace Trinity
+{
+/**
+* Whole file mapped into memory copy-on-write. Pages are backed by the page cache and shared
+* with every other process mapping the same file until they are written to, writes stay private.
+*/
+class TC_COMMON_API MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool Open(std::string const& path);
+    void Close();
+
+    bool IsOpen() const { return _data != nullptr; }
+    uint8* GetData() const { return _data; }
+    std::size_t GetSize() const { return _size; }
+
+private:
+    uint8* _data;
+    std::size_t _size;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+    void* _mapping;
+#endif
+};
+}
+
+#endif // MappedFile_h__
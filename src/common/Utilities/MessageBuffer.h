@@ -19,6 +19,7 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include "BufferPool.h"
 #include <vector>
 #include <cstring>
 
@@ -27,12 +28,12 @@ class MessageBuffer
     typedef std::vector<uint8>::size_type size_type;
 
 public:
-    MessageBuffer() : _wpos(0), _rpos(0), _storage()
+    MessageBuffer() : _wpos(0), _rpos(0), _storage(Trinity::BufferPool::Acquire(4096))
     {
         _storage.resize(4096);
     }
 
-    explicit MessageBuffer(std::size_t initialSize) : _wpos(0), _rpos(0), _storage()
+    explicit MessageBuffer(std::size_t initialSize) : _wpos(0), _rpos(0), _storage(Trinity::BufferPool::Acquire(initialSize))
     {
         _storage.resize(initialSize);
     }
@@ -43,6 +44,11 @@ public:
 
     MessageBuffer(MessageBuffer&& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right.Move()) { }
 
+    ~MessageBuffer()
+    {
+        Trinity::BufferPool::Release(std::move(_storage));
+    }
+
     void Reset()
     {
         _wpos = 0;
@@ -124,6 +130,7 @@ public:
         {
             _wpos = right._wpos;
             _rpos = right._rpos;
+            Trinity::BufferPool::Release(std::move(_storage));
             _storage = right.Move();
         }
 
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PositionBatch_h__
+#define PositionBatch_h__
+
+#include "Define.h"
+#include <algorithm>
+#include <vector>
+
+namespace Trinity
+{
+/**
+* Structure-of-arrays copy of object positions together with their reach and sight range.
+* Filters over it are plain loops without branches or virtual calls that the compiler vectorizes,
+* so a whole cell can be range checked before any of its objects is touched.
+*/
+template<typename T>
+class PositionBatch
+{
+public:
+    void Clear()
+    {
+        _objects.clear();
+        _x.clear();
+        _y.clear();
+        _reach.clear();
+        _range.clear();
+    }
+
+    void Reserve(std::size_t count)
+    {
+        _objects.reserve(count);
+        _x.reserve(count);
+        _y.reserve(count);
+        _reach.reserve(count);
+        _range.reserve(count);
+    }
+
+    void Add(T object, float x, float y, float reach, float range)
+    {
+        _objects.push_back(object);
+        _x.push_back(x);
+        _y.push_back(y);
+        _reach.push_back(reach);
+        _range.push_back(range);
+    }
+
+    std::size_t Size() const { return _objects.size(); }
+    T operator[](std::size_t index) const { return _objects[index]; }
+
+    /**
+    * Sets result[i] for every entry that is within 2d range of the given point in either direction -
+    * the entry seeing the point or the point seeing the entry. Reach of both sides is added to the
+    * range the same way WorldObject::IsWithinDist does it. Returns the number of matching entries.
+    */
+    std::size_t FilterWithinMutualRange2d(float x, float y, float reach, float range, std::vector<uint8>& result) const
+    {
+        std::size_t const count = _objects.size();
+        result.resize(count);
+
+        float const* objX = _x.data();
+        float const* objY = _y.data();
+        float const* objReach = _reach.data();
+        float const* objRange = _range.data();
+        uint8* out = result.data();
+
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float dx = objX[i] - x;
+            float dy = objY[i] - y;
+            float maxDist = std::max(range, objRange[i]) + reach + objReach[i];
+            uint8 match = uint8(dx * dx + dy * dy <= maxDist * maxDist);
+            out[i] = match;
+            matches += match;
+        }
+
+        return matches;
+    }
+
+private:
+    std::vector<T> _objects;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _reach;
+    std::vector<float> _range;
+};
+}
+
+#endif // PositionBatch_h__
@@ -0,0 +1,231 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SpawnCellIndex_h__
+#define SpawnCellIndex_h__
+
+#include "Define.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+/**
+* Index of spawns by (map, spawn mode, cell), stored column wise.
+* Built spawns are sorted by key and spawn id into two contiguous arrays (ids and values) with a
+* sorted table of per-cell ranges on top, so visiting a cell is a binary search over the cells
+* followed by one sequential scan. Spawns added after Build() are kept per cell on the side until
+* the next Build(); removed built spawns are only marked (spawn id 0 is never valid) and skipped.
+*
+* Not thread safe: concurrent const access is fine, modifications must not overlap with readers.
+*/
+template<typename Id, typename Value>
+class SpawnCellIndex
+{
+public:
+    typedef uint64 KeyType;
+
+    static KeyType MakeKey(uint32 map, uint32 cellId) { return (KeyType(map) << 32) | cellId; }
+
+    void Insert(KeyType key, Id id, Value value)
+    {
+        if (Contains(key, id))
+            return;
+
+        _pending[key].push_back({ id, value });
+        ++_pendingCount;
+    }
+
+    bool Remove(KeyType key, Id id)
+    {
+        auto itr = _pending.find(key);
+        if (itr != _pending.end())
+        {
+            std::vector<Entry>& entries = itr->second;
+            auto entry = std::find_if(entries.begin(), entries.end(), [id](Entry const& e) { return e.SpawnId == id; });
+            if (entry != entries.end())
+            {
+                *entry = entries.back();
+                entries.pop_back();
+                if (entries.empty())
+                    _pending.erase(itr);
+
+                --_pendingCount;
+                return true;
+            }
+        }
+
+        if (CellRange const* cell = FindCell(key))
+        {
+            // removed spawns break the ordering of the range, cells are small enough for a linear search
+            auto end = _ids.begin() + cell->End;
+            auto found = std::find(_ids.begin() + cell->Begin, end, id);
+            if (found != end)
+            {
+                *found = Id();
+                ++_removedCount;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Contains(KeyType key, Id id) const
+    {
+        bool found = false;
+        ForEach(key, [id, &found](Id spawnId, Value const&)
+        {
+            found = found || spawnId == id;
+        });
+        return found;
+    }
+
+    // Merges spawns added since the last call into the sorted arrays and drops removed ones
+    void Build()
+    {
+        if (!_pendingCount && !_removedCount)
+            return;
+
+        struct BuildEntry
+        {
+            KeyType Key;
+            Id SpawnId;
+            Value Val;
+        };
+
+        std::vector<BuildEntry> entries;
+        entries.reserve(_ids.size() - _removedCount + _pendingCount);
+        for (CellRange const& cell : _cells)
+            for (uint32 i = cell.Begin; i < cell.End; ++i)
+                if (_ids[i] != Id())
+                    entries.push_back({ cell.Key, _ids[i], _values[i] });
+
+        std::size_t const builtCount = entries.size();
+        for (auto const& pair : _pending)
+            for (Entry const& entry : pair.second)
+                entries.push_back({ pair.first, entry.SpawnId, entry.Val });
+
+        auto less = [](BuildEntry const& left, BuildEntry const& right)
+        {
+            return left.Key < right.Key || (left.Key == right.Key && left.SpawnId < right.SpawnId);
+        };
+
+        // built entries are already in order, only the added ones need sorting
+        std::sort(entries.begin() + builtCount, entries.end(), less);
+        std::inplace_merge(entries.begin(), entries.begin() + builtCount, entries.end(), less);
+
+        _cells.clear();
+        _ids.clear();
+        _values.clear();
+        _ids.reserve(entries.size());
+        _values.reserve(entries.size());
+        for (BuildEntry const& entry : entries)
+        {
+            if (_cells.empty() || _cells.back().Key != entry.Key)
+                _cells.push_back({ entry.Key, uint32(_ids.size()), uint32(_ids.size()) });
+
+            _ids.push_back(entry.SpawnId);
+            _values.push_back(entry.Val);
+            ++_cells.back().End;
+        }
+
+        _cells.shrink_to_fit();
+        _ids.shrink_to_fit();
+        _values.shrink_to_fit();
+
+        _pending.clear();
+        _pendingCount = 0;
+        _removedCount = 0;
+    }
+
+    // Calls fn(id, value) for every spawn in the cell, built spawns in ascending id order first
+    template<typename Fn>
+    void ForEach(KeyType key, Fn&& fn) const
+    {
+        if (CellRange const* cell = FindCell(key))
+            VisitRange(*cell, fn);
+
+        if (_pending.empty())
+            return;
+
+        auto itr = _pending.find(key);
+        if (itr != _pending.end())
+            for (Entry const& entry : itr->second)
+                fn(entry.SpawnId, entry.Val);
+    }
+
+    // Calls fn(id, value) for every spawn with a key in [first, last]
+    template<typename Fn>
+    void ForEachInRange(KeyType first, KeyType last, Fn&& fn) const
+    {
+        auto cell = std::lower_bound(_cells.begin(), _cells.end(), first, [](CellRange const& range, KeyType key) { return range.Key < key; });
+        for (; cell != _cells.end() && cell->Key <= last; ++cell)
+            VisitRange(*cell, fn);
+
+        for (auto const& pair : _pending)
+            if (pair.first >= first && pair.first <= last)
+                for (Entry const& entry : pair.second)
+                    fn(entry.SpawnId, entry.Val);
+    }
+
+    std::size_t GetSize() const { return _ids.size() - _removedCount + _pendingCount; }
+    std::size_t GetCellCount() const { return _cells.size(); }
+
+private:
+    struct CellRange
+    {
+        KeyType Key;
+        uint32 Begin;
+        uint32 End;
+    };
+
+    struct Entry
+    {
+        Id SpawnId;
+        Value Val;
+    };
+
+    CellRange const* FindCell(KeyType key) const
+    {
+        auto cell = std::lower_bound(_cells.begin(), _cells.end(), key, [](CellRange const& range, KeyType k) { return range.Key < k; });
+        if (cell == _cells.end() || cell->Key != key)
+            return nullptr;
+
+        return &*cell;
+    }
+
+    template<typename Fn>
+    void VisitRange(CellRange const& cell, Fn& fn) const
+    {
+        for (uint32 i = cell.Begin; i < cell.End; ++i)
+            if (_ids[i] != Id())
+                fn(_ids[i], _values[i]);
+    }
+
+    std::vector<CellRange> _cells;
+    std::vector<Id> _ids;
+    std::vector<Value> _values;
+
+    std::unordered_map<KeyType, std::vector<Entry>> _pending;
+    std::size_t _pendingCount = 0;
+    std::size_t _removedCount = 0;
+};
+}
+
+#endif // SpawnCellIndex_h__
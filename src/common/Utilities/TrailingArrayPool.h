@@ -0,0 +1,172 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrailingArrayPool_h__
+#define TrailingArrayPool_h__
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Trinity
+{
+/**
+* Recycles memory for objects that are followed by an array of Element sized at creation.
+* A block is a small header, space for one object of at most the size given to the pool and the
+* array of up to 255 elements. Blocks are kept per array size when released, and the elements stay
+* constructed while pooled so any storage they own is reused by the next user of the block.
+*
+* Blocks can be acquired and released on any thread.
+*/
+template<typename Element>
+class TrailingArrayPool
+{
+public:
+    struct Statistics
+    {
+        uint64 Hits = 0;        // acquires served from the pool
+        uint64 Misses = 0;      // acquires that had to allocate
+    };
+
+    TrailingArrayPool(std::size_t objectSize, std::size_t maxPooledPerSize)
+        : _objectSize(AlignUp(objectSize)), _maxPooledPerSize(maxPooledPerSize), _hits(0), _misses(0) { }
+
+    ~TrailingArrayPool()
+    {
+        for (Bucket& bucket : _buckets)
+            for (Header* header : bucket.Blocks)
+                Free(header);
+    }
+
+    /// Returns memory for an object of at most the pool's object size followed by count constructed elements
+    void* Acquire(uint8 count)
+    {
+        Bucket& bucket = _buckets[count];
+        {
+            std::lock_guard<std::mutex> lock(bucket.Lock);
+            if (!bucket.Blocks.empty())
+            {
+                Header* header = bucket.Blocks.back();
+                bucket.Blocks.pop_back();
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return GetObject(header);
+            }
+        }
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        Header* header = static_cast<Header*>(::operator new(HeaderSize + _objectSize + count * sizeof(Element)));
+        header->Pool = this;
+        header->Count = count;
+
+        Element* elements = reinterpret_cast<Element*>(static_cast<char*>(GetObject(header)) + _objectSize);
+        for (uint8 i = 0; i < count; ++i)
+            new (elements + i) Element();
+
+        return GetObject(header);
+    }
+
+    /// Hands the block of an object returned by Acquire back to the pool it came from, the object must already be destroyed
+    static void Release(void* object)
+    {
+        Header* header = GetHeader(object);
+        header->Pool->ReleaseBlock(header);
+    }
+
+    static Element* GetElements(void* object)
+    {
+        return reinterpret_cast<Element*>(static_cast<char*>(object) + GetHeader(object)->Pool->_objectSize);
+    }
+
+    static uint8 GetElementCount(void const* object)
+    {
+        return GetHeader(const_cast<void*>(object))->Count;
+    }
+
+    std::size_t GetObjectSize() const { return _objectSize; }
+
+    /// Hits and misses are counted since the last call
+    Statistics ResetStatistics()
+    {
+        Statistics statistics;
+        statistics.Hits = _hits.exchange(0);
+        statistics.Misses = _misses.exchange(0);
+        return statistics;
+    }
+
+private:
+    struct Header
+    {
+        TrailingArrayPool* Pool;
+        uint8 Count;
+    };
+
+    struct Bucket
+    {
+        std::mutex Lock;
+        std::vector<Header*> Blocks;
+    };
+
+    static constexpr std::size_t AlignUp(std::size_t size)
+    {
+        return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    }
+
+    static constexpr std::size_t HeaderSize = AlignUp(sizeof(Header));
+
+    static void* GetObject(Header* header) { return reinterpret_cast<char*>(header) + HeaderSize; }
+    static Header* GetHeader(void* object) { return reinterpret_cast<Header*>(static_cast<char*>(object) - HeaderSize); }
+
+    void ReleaseBlock(Header* header)
+    {
+        Bucket& bucket = _buckets[header->Count];
+        {
+            std::lock_guard<std::mutex> lock(bucket.Lock);
+            if (bucket.Blocks.size() < _maxPooledPerSize)
+            {
+                bucket.Blocks.push_back(header);
+                return;
+            }
+        }
+
+        Free(header);
+    }
+
+    void Free(Header* header)
+    {
+        Element* elements = reinterpret_cast<Element*>(static_cast<char*>(GetObject(header)) + _objectSize);
+        for (uint8 i = 0; i < header->Count; ++i)
+            elements[i].~Element();
+
+        ::operator delete(header);
+    }
+
+    std::size_t const _objectSize;
+    std::size_t const _maxPooledPerSize;
+    std::array<Bucket, 256> _buckets;
+    std::atomic<uint64> _hits;
+    std::atomic<uint64> _misses;
+
+    TrailingArrayPool(TrailingArrayPool const& right) = delete;
+    TrailingArrayPool& operator=(TrailingArrayPool const& right) = delete;
+};
+}
+
+#endif // TrailingArrayPool_h__
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UpdateMaskBits_h__
+#define UpdateMaskBits_h__
+
+#include "Define.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// Helpers for update masks packed into 32 bit blocks, one bit per field
+namespace UpdateMaskBits
+{
+    inline uint32 CountTrailingZeros(uint32 value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+
+    inline constexpr uint32 CalculateBlockCount(uint32 fieldCount) { return (fieldCount + 31) / 32; }
+
+    /// Adds the fields an update for a receiver carries to mask: fields set in notify, plus fields set in visible
+    /// that are set in changes (values update) or have a non-zero value (create update).
+    /// Bits past valuesCount are cleared, the visibility masks of units are sized for players.
+    inline void SelectFields(uint32* mask, uint32 valuesCount, bool valuesUpdate, uint32 const* changes, uint32 const* values,
+        uint32 const* visible, uint32 const* notify)
+    {
+        uint32 blockCount = CalculateBlockCount(valuesCount);
+        for (uint32 block = 0; block < blockCount; ++block)
+        {
+            uint32 selected = visible[block];
+            if (valuesUpdate)
+                selected &= changes[block];
+            else
+            {
+                for (uint32 bits = selected; bits; bits &= bits - 1)
+                {
+                    uint32 index = block * 32 + CountTrailingZeros(bits);
+                    if (index < valuesCount && !values[index])
+                        selected &= ~(1u << (index % 32));
+                }
+            }
+
+            mask[block] |= selected | notify[block];
+        }
+
+        if (uint32 tail = valuesCount % 32)
+            mask[blockCount - 1] &= (1u << tail) - 1;
+    }
+
+    /// Number of blocks up to the last one with a set bit, the client always reads at least one block
+    inline uint32 CountUsedBlocks(uint32 const* mask, uint32 blockCount)
+    {
+        while (blockCount > 1 && !mask[blockCount - 1])
+            --blockCount;
+
+        return blockCount;
+    }
+}
+
+#endif // UpdateMaskBits_h__
@@ -30,6 +30,7 @@ class TC_DATABASE_API BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute() override;
+        bool IsBatchable() const override { return !m_has_result; }
         QueryResultFuture GetFuture() const { return m_result->get_future(); }
 
     private:
@@ -53,6 +53,8 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetBatchLimits(uint32(sConfigMgr->GetIntDefault(name + "Database.BatchStatements", 0)),
+            uint32(sConfigMgr->GetIntDefault(name + "Database.BatchMaxDelay", 10)));
         if (uint32 error = pool.Open())
         {
             // Database does not exist
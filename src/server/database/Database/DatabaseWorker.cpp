@@ -16,14 +16,52 @@
  */
 
 #include "DatabaseWorker.h"
+#include "Log.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+uint32 DatabaseQueueLatency::GetBucketLimit(std::size_t bucket)
+{
+    static uint32 const limits[BucketCount - 1] = { 1, 5, 10, 50, 100, 500, 1000 };
+    return bucket < BucketCount - 1 ? limits[bucket] : std::numeric_limits<uint32>::max();
+}
+
+std::size_t DatabaseQueueLatency::GetBucket(uint32 latency)
+{
+    std::size_t bucket = 0;
+    while (bucket < BucketCount - 1 && latency >= GetBucketLimit(bucket))
+        ++bucket;
+
+    return bucket;
+}
+
+uint32 DatabaseQueueLatency::GetPercentile(uint32 percent) const
+{
+    uint64 const target = (Operations * percent + 99) / 100;
+    uint64 count = 0;
+    for (std::size_t bucket = 0; bucket < BucketCount; ++bucket)
+    {
+        count += Buckets[bucket];
+        if (count && count >= target)
+            return GetBucketLimit(bucket < BucketCount - 1 ? bucket : bucket - 1);
+    }
+
+    return 0;
+}
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+    : _batchMaxStatements(0), _batchMaxDelay(0), _batchedOperations(0), _batches(0), _batchCommitTime(0)
 {
     _connection = connection;
     _queue = newQueue;
     _cancelationToken = false;
+    for (std::atomic<uint64>& bucket : _queueLatency)
+        bucket = 0;
+
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
@@ -36,6 +74,33 @@ DatabaseWorker::~DatabaseWorker()
     _workerThread.join();
 }
 
+void DatabaseWorker::SetBatchLimits(uint32 maxStatements, uint32 maxDelay)
+{
+    _batchMaxStatements = maxStatements;
+    _batchMaxDelay = maxDelay;
+}
+
+DatabaseBatchStatistics DatabaseWorker::ResetBatchStatistics()
+{
+    DatabaseBatchStatistics statistics;
+    statistics.Operations = _batchedOperations.exchange(0);
+    statistics.Batches = _batches.exchange(0);
+    statistics.CommitTime = _batchCommitTime.exchange(0);
+    return statistics;
+}
+
+DatabaseQueueLatency DatabaseWorker::ResetQueueLatency()
+{
+    DatabaseQueueLatency latency;
+    for (std::size_t bucket = 0; bucket < DatabaseQueueLatency::BucketCount; ++bucket)
+    {
+        latency.Buckets[bucket] = _queueLatency[bucket].exchange(0);
+        latency.Operations += latency.Buckets[bucket];
+    }
+
+    return latency;
+}
+
 void DatabaseWorker::WorkerThread()
 {
     if (!_queue)
@@ -50,9 +115,127 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
-        operation->SetConnection(_connection);
-        operation->call();
+        Prepare(operation);
+
+        // a batch hands back the first queued operation it could not take
+        while (operation && operation->IsBatchable() && _batchMaxStatements)
+            operation = ExecuteBatch(operation);
+
+        if (operation)
+            Run(operation);
+    }
+}
+
+SQLOperation* DatabaseWorker::TryPop()
+{
+    SQLOperation* operation = nullptr;
+    if (_cancelationToken || !_queue->Pop(operation) || !operation)
+        return nullptr;
+
+    Prepare(operation);
+    return operation;
+}
+
+void DatabaseWorker::Prepare(SQLOperation* operation)
+{
+    operation->SetConnection(_connection);
+
+    auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - operation->m_queueTime).count();
+    ++_queueLatency[DatabaseQueueLatency::GetBucket(uint32(std::max<int64>(waited, 0)))];
+}
+
+void DatabaseWorker::Run(SQLOperation* operation)
+{
+    operation->call();
+    delete operation;
+}
+
+void DatabaseWorker::RunEach(std::vector<SQLOperation*>& operations)
+{
+    for (SQLOperation* operation : operations)
+        Run(operation);
+
+    operations.clear();
+}
+
+SQLOperation* DatabaseWorker::ExecuteBatch(SQLOperation* operation)
+{
+    // Statements run as soon as they are popped, only the commit is shared. Nothing waits for more
+    // work: a batch ends when the queue runs dry, a non batchable operation shows up or a limit is hit.
+    SQLOperation* next = TryPop();
+    if (!next || !next->IsBatchable())
+    {
+        Run(operation);
+        return next;
+    }
+
+    uint32 const maxStatements = _batchMaxStatements;
+    std::chrono::steady_clock::time_point const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_batchMaxDelay);
+    uint32 statements = 0;
+
+    std::vector<SQLOperation*> batch;
+    _connection->BeginTransaction();
+
+    // A statement must never run again on a reestablished connection while the transaction is open, it would
+    // execute outside of it and ahead of the lost ones. Failures are replayed below in the original order instead.
+    uint32 const reconnectCount = _connection->GetReconnectCount();
+    _connection->SetRetryAfterReconnect(false);
+    while (operation)
+    {
+        batch.push_back(operation);
+        statements += operation->GetStatementCount();
+
+        bool const executed = operation->ExecuteBatched();
+        if (_connection->GetReconnectCount() != reconnectCount)
+        {
+            // the open transaction went away with the old connection, nothing of the batch was written
+            TC_LOG_WARN("sql.sql", "Connection lost during a batch of %u operations, executing them one by one.", uint32(batch.size()));
+            _connection->SetRetryAfterReconnect(true);
+            RunEach(batch);
+            return next;
+        }
+
+        if (!executed)
+        {
+            TC_LOG_WARN("sql.sql", "Batch of %u operations aborted, executing them one by one.", uint32(batch.size()));
+            _connection->SetRetryAfterReconnect(true);
+            _connection->RollbackTransaction();
+            RunEach(batch);
+            return next;
+        }
+
+        if (statements >= maxStatements || std::chrono::steady_clock::now() >= deadline)
+            break;
 
-        delete operation;
+        operation = next ? next : TryPop();
+        next = nullptr;
+        if (operation && !operation->IsBatchable())
+        {
+            next = operation;
+            operation = nullptr;
+        }
     }
+
+    std::chrono::steady_clock::time_point const commitStart = std::chrono::steady_clock::now();
+    bool const committed = _connection->CommitTransaction() && _connection->GetReconnectCount() == reconnectCount;
+    _connection->SetRetryAfterReconnect(true);
+    if (!committed)
+    {
+        TC_LOG_WARN("sql.sql", "Commit of a batch of %u operations failed, executing them one by one.", uint32(batch.size()));
+        _connection->RollbackTransaction();
+        RunEach(batch);
+        return next;
+    }
+
+    _batchCommitTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - commitStart).count();
+    _batchedOperations += batch.size();
+    ++_batches;
+
+    for (SQLOperation* executed : batch)
+    {
+        executed->BatchCommitted();
+        delete executed;
+    }
+
+    return next;
 }
@@ -19,8 +19,10 @@
 #define _WORKERTHREAD_H
 
 #include "Define.h"
+#include <array>
 #include <atomic>
 #include <thread>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -28,21 +30,66 @@ class ProducerConsumerQueue;
 class MySQLConnection;
 class SQLOperation;
 
+struct DatabaseBatchStatistics
+{
+    uint64 Operations = 0;      //! One-way operations committed as part of a batch
+    uint64 Batches = 0;         //! Batch transactions committed
+    uint64 CommitTime = 0;      //! Time spent committing batches, in microseconds
+};
+
+//! Histogram of the time operations waited in the queue before a worker picked them up
+struct TC_DATABASE_API DatabaseQueueLatency
+{
+    static constexpr std::size_t BucketCount = 8;
+
+    //! Upper bound of the bucket in milliseconds, the last bucket has none
+    static uint32 GetBucketLimit(std::size_t bucket);
+    static std::size_t GetBucket(uint32 latency);
+
+    //! Upper bound of the bucket holding the given percentile of operations, in milliseconds.
+    //! Operations in the last bucket are reported with the lower bound of it.
+    uint32 GetPercentile(uint32 percent) const;
+
+    std::array<uint64, BucketCount> Buckets = { };
+    uint64 Operations = 0;
+};
+
 class TC_DATABASE_API DatabaseWorker
 {
     public:
         DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        //! Queued one-way operations are committed in one transaction, up to maxStatements statements
+        //! or maxDelay milliseconds since the first one. 0 statements disables batching.
+        void SetBatchLimits(uint32 maxStatements, uint32 maxDelay);
+
+        DatabaseBatchStatistics ResetBatchStatistics();
+
+        DatabaseQueueLatency ResetQueueLatency();
+
     private:
         ProducerConsumerQueue<SQLOperation*>* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
+        SQLOperation* TryPop();
+        void Prepare(SQLOperation* operation);
+        void Run(SQLOperation* operation);
+        void RunEach(std::vector<SQLOperation*>& operations);
+        SQLOperation* ExecuteBatch(SQLOperation* operation);
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
 
+        std::atomic<uint32> _batchMaxStatements;
+        std::atomic<uint32> _batchMaxDelay;
+        std::atomic<uint64> _batchedOperations;
+        std::atomic<uint64> _batches;
+        std::atomic<uint64> _batchCommitTime;
+
+        std::array<std::atomic<uint64>, DatabaseQueueLatency::BucketCount> _queueLatency;
+
         DatabaseWorker(DatabaseWorker const& right) = delete;
         DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
 };
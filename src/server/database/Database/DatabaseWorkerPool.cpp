@@ -34,10 +34,20 @@
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
 
 #define MIN_MYSQL_SERVER_VERSION 50100u
 #define MIN_MYSQL_CLIENT_VERSION 50100u
 
+//! Statements of a connection type are recycled per parameter count, never destroyed as statements
+//! may still be deleted by static objects destroyed at exit
+template <class T>
+PreparedStatementPool& GetPreparedStatementPool()
+{
+    static PreparedStatementPool* pool = new PreparedStatementPool(sizeof(PreparedStatement<T>), 512);
+    return *pool;
+}
+
 class PingOperation : public SQLOperation
 {
     //! Operation for idle delaythreads
@@ -50,8 +60,7 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
-      _async_threads(0), _synch_threads(0)
+    : _nextQueue(0), _async_threads(0), _synch_threads(0), _batchMaxStatements(0), _batchMaxDelay(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
     WPFatal(mysql_get_client_version() >= MIN_MYSQL_CLIENT_VERSION, "TrinityCore does not support MySQL versions below 5.1");
@@ -62,7 +71,8 @@ DatabaseWorkerPool<T>::DatabaseWorkerPool()
 template <class T>
 DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 {
-    _queue->Cancel();
+    for (auto& queue : _queues)
+        queue->Cancel();
 }
 
 template <class T>
@@ -73,6 +83,22 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
+
+    //! Without async connections operations stay in the first queue, same as with a single shared queue
+    _queues.clear();
+    for (uint8 i = 0; i < std::max<uint8>(asyncThreads, 1); ++i)
+        _queues.push_back(Trinity::make_unique<ProducerConsumerQueue<SQLOperation*>>());
+
+    _queueLoads = Trinity::make_unique<std::atomic<uint32>[]>(_queues.size());
+    for (std::size_t i = 0; i < _queues.size(); ++i)
+        _queueLoads[i] = 0;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetBatchLimits(uint32 maxStatements, uint32 maxDelay)
+{
+    _batchMaxStatements = maxStatements;
+    _batchMaxDelay = maxDelay;
 }
 
 template <class T>
@@ -183,6 +209,27 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
     return QueryResult(result);
 }
 
+template <class T>
+QueryResult DatabaseWorkerPool<T>::StreamQuery(char const* sql)
+{
+    T* connection = GetFreeConnection();
+    ResultSet* result = connection->StreamQuery(sql);
+    if (!result)
+    {
+        connection->Unlock();
+        return QueryResult(nullptr);
+    }
+
+    // the connection is unlocked by the result once all rows were read
+    if (!result->NextRow())
+    {
+        delete result;
+        return QueryResult(nullptr);
+    }
+
+    return QueryResult(result);
+}
+
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
@@ -213,22 +260,22 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt, SQLOrderingKey key)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, key);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, SQLOrderingKey key)
 {
     SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, key);
     return { std::move(holder), std::move(result) };
 }
 
@@ -239,7 +286,7 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, SQLOrderingKey key)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -258,11 +305,11 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), key);
 }
 
 template <class T>
-TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction)
+TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction, SQLOrderingKey key)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -283,7 +330,7 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
 
     TransactionWithResultTask* task = new TransactionWithResultTask(transaction);
     TransactionFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, key);
     return TransactionCallback(std::move(result));
 }
 
@@ -320,7 +367,7 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transacti
 template <class T>
 PreparedStatement<T>* DatabaseWorkerPool<T>::GetPreparedStatement(PreparedStatementIndex index)
 {
-    return new PreparedStatement<T>(index, _preparedStatementSize[index]);
+    return new (GetPreparedStatementPool<T>(), _preparedStatementSize[index]) PreparedStatement<T>(index, _preparedStatementSize[index]);
 }
 
 template <class T>
@@ -348,12 +395,45 @@ void DatabaseWorkerPool<T>::KeepAlive()
         }
     }
 
-    //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-    //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-    //! as the sole purpose is to prevent connections from idling.
-    auto const count = _connections[IDX_ASYNC].size();
-    for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+    //! Every async connection has its own queue, ping each one of them
+    for (auto& queue : _queues)
+    {
+        PingOperation* ping = new PingOperation();
+        ping->m_queueTime = std::chrono::steady_clock::now();
+        queue->Push(ping);
+    }
+}
+
+template <class T>
+DatabaseBatchStatistics DatabaseWorkerPool<T>::ResetBatchStatistics()
+{
+    DatabaseBatchStatistics statistics;
+    for (auto& connection : _connections[IDX_ASYNC])
+    {
+        DatabaseBatchStatistics workerStatistics = connection->m_worker->ResetBatchStatistics();
+        statistics.Operations += workerStatistics.Operations;
+        statistics.Batches += workerStatistics.Batches;
+        statistics.CommitTime += workerStatistics.CommitTime;
+    }
+
+    return statistics;
+}
+
+template <class T>
+PreparedStatementPool::Statistics DatabaseWorkerPool<T>::ResetPreparedStatementPoolStatistics()
+{
+    return GetPreparedStatementPool<T>().ResetStatistics();
+}
+
+template <class T>
+std::vector<DatabaseQueueLatency> DatabaseWorkerPool<T>::ResetQueueLatencies()
+{
+    std::vector<DatabaseQueueLatency> latencies;
+    latencies.reserve(_connections[IDX_ASYNC].size());
+    for (auto& connection : _connections[IDX_ASYNC])
+        latencies.push_back(connection->m_worker->ResetQueueLatency());
+
+    return latencies;
 }
 
 template <class T>
@@ -366,7 +446,7 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
             switch (type)
             {
             case IDX_ASYNC:
-                return Trinity::make_unique<T>(_queue.get(), *_connectionInfo);
+                return Trinity::make_unique<T>(_queues[i].get(), *_connectionInfo);
             case IDX_SYNCH:
                 return Trinity::make_unique<T>(*_connectionInfo);
             default:
@@ -387,6 +467,9 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
         }
         else
         {
+            if (type == IDX_ASYNC)
+                connection->m_worker->SetBatchLimits(_batchMaxStatements, _batchMaxDelay);
+
             _connections[type].push_back(std::move(connection));
         }
     }
@@ -405,9 +488,37 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, SQLOrderingKey key)
+{
+    std::size_t index = GetQueueIndex(key);
+    op->m_queueTime = std::chrono::steady_clock::now();
+    op->m_queueLoad = &_queueLoads[index];
+    ++_queueLoads[index];
+    _queues[index]->Push(op);
+}
+
+template <class T>
+std::size_t DatabaseWorkerPool<T>::GetQueueIndex(SQLOrderingKey const& key)
 {
-    _queue->Push(op);
+    if (key)
+        return key.GetHash() % _queues.size();
+
+    // the search starts at a different queue every time, ties (idle workers) are still spread round robin
+    std::size_t const first = _nextQueue++ % _queues.size();
+    std::size_t best = first;
+    uint32 bestLoad = _queueLoads[first];
+    for (std::size_t i = 1; i < _queues.size() && bestLoad; ++i)
+    {
+        std::size_t index = (first + i) % _queues.size();
+        uint32 load = _queueLoads[index];
+        if (load < bestLoad)
+        {
+            best = index;
+            bestLoad = load;
+        }
+    }
+
+    return best;
 }
 
 template <class T>
@@ -445,10 +556,10 @@ void DatabaseWorkerPool<T>::Execute(char const* sql)
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, SQLOrderingKey key)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, key);
 }
 
 template <class T>
@@ -483,10 +594,10 @@ void DatabaseWorkerPool<T>::ExecuteOrAppend(SQLTransaction<T>& trans, char const
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::ExecuteOrAppend(SQLTransaction<T>& trans, PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::ExecuteOrAppend(SQLTransaction<T>& trans, PreparedStatement<T>* stmt, SQLOrderingKey key)
 {
     if (!trans)
-        Execute(stmt);
+        Execute(stmt, key);
     else
         trans->Append(stmt);
 }
@@ -20,8 +20,12 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "DatabaseWorker.h"
+#include "PreparedStatement.h"
+#include "SQLOrderingKey.h"
 #include "StringFormat.h"
 #include <array>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -50,6 +54,9 @@ class DatabaseWorkerPool
 
         void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+        //! Lets async workers commit queued one-way statements and transactions together, see DatabaseWorker::SetBatchLimits.
+        void SetBatchLimits(uint32 maxStatements, uint32 maxDelay);
+
         uint32 Open();
 
         void Close();
@@ -83,7 +90,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement<T>* stmt);
+        void Execute(PreparedStatement<T>* stmt, SQLOrderingKey key = SQLOrderingKey());
 
         /**
             Direct synchronous one-way statement methods.
@@ -116,6 +123,13 @@ class DatabaseWorkerPool
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         QueryResult Query(char const* sql, T* connection = nullptr);
 
+        //! Directly executes an SQL query in string format and reads its rows from the server one at a time
+        //! instead of buffering the whole result, meant for loading large tables at startup.
+        //! A synchronous connection stays reserved until all rows were read or the result is destroyed,
+        //! other synchronous queries must not be run on this pool from inside the read loop.
+        //! GetRowCount() of the returned result is 0.
+        QueryResult StreamQuery(char const* sql);
+
         //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         template<typename Format, typename... Args>
@@ -154,13 +168,13 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        QueryCallback AsyncQuery(PreparedStatement<T>* stmt);
+        QueryCallback AsyncQuery(PreparedStatement<T>* stmt, SQLOrderingKey key = SQLOrderingKey());
 
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, SQLOrderingKey key = SQLOrderingKey());
 
         /**
             Transaction context methods.
@@ -171,11 +185,11 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction<T> transaction);
+        void CommitTransaction(SQLTransaction<T> transaction, SQLOrderingKey key = SQLOrderingKey());
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction);
+        TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction, SQLOrderingKey key = SQLOrderingKey());
 
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
@@ -187,7 +201,7 @@ class DatabaseWorkerPool
 
         //! Method used to execute prepared statements in a diverse context.
         //! Will be wrapped in a transaction if valid object is present, otherwise executed standalone.
-        void ExecuteOrAppend(SQLTransaction<T>& trans, PreparedStatement<T>* stmt);
+        void ExecuteOrAppend(SQLTransaction<T>& trans, PreparedStatement<T>* stmt, SQLOrderingKey key = SQLOrderingKey());
 
         /**
             Other
@@ -206,12 +220,25 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Batching counters of all async workers since the last call.
+        DatabaseBatchStatistics ResetBatchStatistics();
+
+        //! Prepared statements reused from and allocated for the statement pool of this connection type since the last call.
+        PreparedStatementPool::Statistics ResetPreparedStatementPoolStatistics();
+
+        //! Queue latency of every async connection since the last call, indexed by queue.
+        std::vector<DatabaseQueueLatency> ResetQueueLatencies();
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-        void Enqueue(SQLOperation* op);
+        void Enqueue(SQLOperation* op, SQLOrderingKey key = SQLOrderingKey());
+
+        //! Operations with a key always go to the same queue, the others to the queue with the least operations
+        //! waiting or running, so they do not line up behind a slow one while other workers are idle.
+        std::size_t GetQueueIndex(SQLOrderingKey const& key);
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -219,12 +246,16 @@ class DatabaseWorkerPool
 
         char const* GetDatabaseName() const;
 
-        //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        //! Operations of each queue not deleted yet, outlives the queues and workers referencing them.
+        std::unique_ptr<std::atomic<uint32>[]> _queueLoads;
+        //! One queue per async worker thread.
+        std::vector<std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>> _queues;
+        std::atomic<uint32> _nextQueue;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
         uint8 _async_threads, _synch_threads;
+        uint32 _batchMaxStatements, _batchMaxDelay;
 };
 
 #endif
@@ -48,6 +48,8 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -56,6 +58,8 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -181,7 +185,7 @@ bool MySQLConnection::Execute(char const* sql)
             TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-                return Execute(sql);       // Try again
+                return m_retryAfterReconnect && Execute(sql);       // Try again
 
             return false;
         }
@@ -216,7 +220,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+            return m_retryAfterReconnect && Execute(stmt);       // Try again
 
         m_mStmt->ClearParameters();
         return false;
@@ -228,7 +232,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+            return m_retryAfterReconnect && Execute(stmt);       // Try again
 
         m_mStmt->ClearParameters();
         return false;
@@ -351,6 +355,35 @@ bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField*
     return true;
 }
 
+ResultSet* MySQLConnection::StreamQuery(char const* sql)
+{
+    if (!m_Mysql || !sql)
+        return nullptr;
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(m_Mysql, sql))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_INFO("sql.sql", "SQL: %s", sql);
+        TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql);        // We try again
+
+        return nullptr;
+    }
+    else
+        TC_LOG_DEBUG("sql.sql", "[%u ms] SQL (streamed): %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+    MySQLResult* result = reinterpret_cast<MySQLResult*>(mysql_use_result(m_Mysql));
+    if (!result)
+        return nullptr;
+
+    MySQLField* fields = reinterpret_cast<MySQLField*>(mysql_fetch_fields(result));
+    return new ResultSet(result, fields, mysql_field_count(m_Mysql), this);
+}
+
 void MySQLConnection::BeginTransaction()
 {
     Execute("START TRANSACTION");
@@ -361,9 +394,9 @@ void MySQLConnection::RollbackTransaction()
     Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transaction)
@@ -374,6 +407,24 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
+    if (int errorCode = ExecuteTransactionStatements(transaction))
+    {
+        RollbackTransaction();
+        return errorCode;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return 0;
+}
+
+int MySQLConnection::ExecuteTransactionStatements(std::shared_ptr<TransactionBase> const& transaction)
+{
+    std::vector<SQLElementData> const& queries = transaction->m_queries;
     for (auto itr = queries.begin(); itr != queries.end(); ++itr)
     {
         SQLElementData const& data = *itr;
@@ -386,9 +437,7 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
                 if (!Execute(stmt))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
+                    return GetLastError();
                 }
                 break;
             }
@@ -399,21 +448,13 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
                 if (!Execute(sql))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
+                    return GetLastError();
                 }
                 break;
             }
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
-
-    CommitTransaction();
     return 0;
 }
 
@@ -469,6 +510,14 @@ void MySQLConnection::PrepareStatement(uint32 index, std::string const& sql, Con
         return;
     }
 
+    if (flags & CONNECTION_NO_BATCH)
+    {
+        if (m_unbatchableStmts.size() <= index)
+            m_unbatchableStmts.resize(index + 1);
+
+        m_unbatchableStmts[index] = true;
+    }
+
     MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
     if (!stmt)
     {
@@ -545,6 +594,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
                         (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnectCount;
                 return true;
             }
 
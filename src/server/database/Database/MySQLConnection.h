@@ -37,7 +37,9 @@ enum ConnectionFlags
 {
     CONNECTION_ASYNC = 0x1,
     CONNECTION_SYNCH = 0x2,
-    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH,
+    CONNECTION_NO_BATCH = 0x4,                                  // statement commits implicitly (DDL, TRUNCATE), never executed inside a batch
+    CONNECTION_ASYNC_NO_BATCH = CONNECTION_ASYNC | CONNECTION_NO_BATCH
 };
 
 struct TC_DATABASE_API MySQLConnectionInfo
@@ -55,6 +57,7 @@ class TC_DATABASE_API MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class PingOperation;
+    friend class ResultSet;
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
@@ -72,16 +75,28 @@ class TC_DATABASE_API MySQLConnection
         PreparedResultSet* Query(PreparedStatementBase* stmt);
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatementBase* stmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
+        //! Rows are fetched from the server one at a time while the result is read. The returned
+        //! result keeps the (locked) connection until its last row was read or it is destroyed.
+        ResultSet* StreamQuery(char const* sql);
 
         void BeginTransaction();
         void RollbackTransaction();
-        void CommitTransaction();
+        bool CommitTransaction();
         int ExecuteTransaction(std::shared_ptr<TransactionBase> transaction);
+        //! Executes the statements of the transaction without starting or ending one, returns the error of the first failed statement
+        int ExecuteTransactionStatements(std::shared_ptr<TransactionBase> const& transaction);
         size_t EscapeString(char* to, const char* from, size_t length);
         void Ping();
 
         uint32 GetLastError();
 
+        //! Number of times the connection was reestablished, an open transaction is lost when it changes
+        uint32 GetReconnectCount() const { return m_reconnectCount; }
+        //! Statements are executed again after a reconnect unless disabled, an open transaction can not be continued that way
+        void SetRetryAfterReconnect(bool retry) { m_retryAfterReconnect = retry; }
+        //! False for statements prepared with CONNECTION_NO_BATCH
+        bool CanBatchStatement(uint32 index) const { return index >= m_unbatchableStmts.size() || !m_unbatchableStmts[index]; }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -99,8 +114,11 @@ class TC_DATABASE_API MySQLConnection
         typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
+        std::vector<bool>                    m_unbatchableStmts; //! Statements prepared with CONNECTION_NO_BATCH
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        uint32                               m_reconnectCount; //! Successful reconnects so far
+        bool                                 m_retryAfterReconnect; //! Execute failed statements again once reconnected?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
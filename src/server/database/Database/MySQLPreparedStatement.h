@@ -39,18 +39,19 @@ class TC_DATABASE_API MySQLPreparedStatement
         MySQLPreparedStatement(MySQLStmt* stmt, std::string queryString);
         ~MySQLPreparedStatement();
 
+        //! Parameters are bound by address, values must stay alive until ClearParameters()
         void setNull(const uint8 index);
-        void setBool(const uint8 index, const bool value);
-        void setUInt8(const uint8 index, const uint8 value);
-        void setUInt16(const uint8 index, const uint16 value);
-        void setUInt32(const uint8 index, const uint32 value);
-        void setUInt64(const uint8 index, const uint64 value);
-        void setInt8(const uint8 index, const int8 value);
-        void setInt16(const uint8 index, const int16 value);
-        void setInt32(const uint8 index, const int32 value);
-        void setInt64(const uint8 index, const int64 value);
-        void setFloat(const uint8 index, const float value);
-        void setDouble(const uint8 index, const double value);
+        void setBool(const uint8 index, bool const& value);
+        void setUInt8(const uint8 index, uint8 const& value);
+        void setUInt16(const uint8 index, uint16 const& value);
+        void setUInt32(const uint8 index, uint32 const& value);
+        void setUInt64(const uint8 index, uint64 const& value);
+        void setInt8(const uint8 index, int8 const& value);
+        void setInt16(const uint8 index, int16 const& value);
+        void setInt32(const uint8 index, int32 const& value);
+        void setInt64(const uint8 index, int64 const& value);
+        void setFloat(const uint8 index, float const& value);
+        void setDouble(const uint8 index, double const& value);
         void setBinary(const uint8 index, const std::vector<uint8>& value, bool isString);
 
         uint32 GetParameterCount() const { return m_paramCount; }
@@ -67,6 +68,7 @@ class TC_DATABASE_API MySQLPreparedStatement
         MySQLStmt* m_Mstmt;
         uint32 m_paramCount;
         std::vector<bool> m_paramsSet;
+        std::vector<unsigned long> m_lengths;
         MySQLBind* m_bind;
         std::string const m_queryString;
 
@@ -23,18 +23,106 @@
 #include "Log.h"
 #include "MySQLWorkaround.h"
 
+#define MAX_RECYCLED_BINARY_SIZE 4096
+
 PreparedStatementBase::PreparedStatementBase(uint32 index, uint8 capacity) :
-m_stmt(nullptr), m_index(index), statement_data(capacity) { }
+m_stmt(nullptr), m_index(index), statement_data(PreparedStatementPool::GetElements(this)), m_paramCount(capacity)
+{
+    ASSERT(PreparedStatementPool::GetElementCount(this) == capacity);
+
+    // recycled parameters keep the storage of their previous binary value unless it got large
+    for (uint8 i = 0; i < m_paramCount; ++i)
+    {
+        statement_data[i].data.ui64 = 0;
+        statement_data[i].type = TYPE_BOOL;
+        if (statement_data[i].binary.capacity() > MAX_RECYCLED_BINARY_SIZE)
+            std::vector<uint8>().swap(statement_data[i].binary);
+        else
+            statement_data[i].binary.clear();
+    }
+}
 
 PreparedStatementBase::~PreparedStatementBase() { }
 
+void* PreparedStatementBase::operator new(std::size_t size, PreparedStatementPool& pool, uint8 capacity)
+{
+    ASSERT(size <= pool.GetObjectSize());
+    return pool.Acquire(capacity);
+}
+
+void PreparedStatementBase::operator delete(void* ptr, PreparedStatementPool& /*pool*/, uint8 /*capacity*/)
+{
+    PreparedStatementPool::Release(ptr);
+}
+
+void PreparedStatementBase::operator delete(void* ptr)
+{
+    if (ptr)
+        PreparedStatementPool::Release(ptr);
+}
+
+uint64 PreparedStatementBase::GetHash() const
+{
+    // 64 bit FNV-1a
+    uint64 hash = UI64LIT(14695981039346656037);
+    auto add = [&hash](void const* data, std::size_t size)
+    {
+        for (uint8 const* byte = static_cast<uint8 const*>(data); size; --size, ++byte)
+            hash = (hash ^ *byte) * UI64LIT(1099511628211);
+    };
+
+    add(&m_index, sizeof(m_index));
+    for (uint8 i = 0; i < m_paramCount; ++i)
+    {
+        PreparedStatementData const& param = statement_data[i];
+        uint8 type = uint8(param.type);
+        add(&type, sizeof(type));
+        switch (param.type)
+        {
+            case TYPE_BOOL:
+                add(&param.data.boolean, sizeof(param.data.boolean));
+                break;
+            case TYPE_UI8:
+            case TYPE_I8:
+                add(&param.data.ui8, sizeof(param.data.ui8));
+                break;
+            case TYPE_UI16:
+            case TYPE_I16:
+                add(&param.data.ui16, sizeof(param.data.ui16));
+                break;
+            case TYPE_UI32:
+            case TYPE_I32:
+            case TYPE_FLOAT:
+                add(&param.data.ui32, sizeof(param.data.ui32));
+                break;
+            case TYPE_UI64:
+            case TYPE_I64:
+            case TYPE_DOUBLE:
+                add(&param.data.ui64, sizeof(param.data.ui64));
+                break;
+            case TYPE_STRING:
+            case TYPE_BINARY:
+            {
+                uint32 size = uint32(param.binary.size());
+                add(&size, sizeof(size));
+                add(param.binary.data(), param.binary.size());
+                break;
+            }
+            case TYPE_NULL:
+                break;
+        }
+    }
+
+    return hash;
+}
+
 void PreparedStatementBase::BindParameters(MySQLPreparedStatement* stmt)
 {
     ASSERT(stmt);
     m_stmt = stmt;
 
     uint8 i = 0;
-    for (; i < statement_data.size(); i++)
+    for (; i < m_paramCount; i++)
     {
         switch (statement_data[i].type)
         {
@@ -91,84 +179,84 @@ void PreparedStatementBase::BindParameters(MySQLPreparedStatement* stmt)
 //- Bind to buffer
 void PreparedStatementBase::setBool(const uint8 index, const bool value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.boolean = value;
     statement_data[index].type = TYPE_BOOL;
 }
 
 void PreparedStatementBase::setUInt8(const uint8 index, const uint8 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.ui8 = value;
     statement_data[index].type = TYPE_UI8;
 }
 
 void PreparedStatementBase::setUInt16(const uint8 index, const uint16 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.ui16 = value;
     statement_data[index].type = TYPE_UI16;
 }
 
 void PreparedStatementBase::setUInt32(const uint8 index, const uint32 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.ui32 = value;
     statement_data[index].type = TYPE_UI32;
 }
 
 void PreparedStatementBase::setUInt64(const uint8 index, const uint64 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.ui64 = value;
     statement_data[index].type = TYPE_UI64;
 }
 
 void PreparedStatementBase::setInt8(const uint8 index, const int8 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.i8 = value;
     statement_data[index].type = TYPE_I8;
 }
 
 void PreparedStatementBase::setInt16(const uint8 index, const int16 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.i16 = value;
     statement_data[index].type = TYPE_I16;
 }
 
 void PreparedStatementBase::setInt32(const uint8 index, const int32 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.i32 = value;
     statement_data[index].type = TYPE_I32;
 }
 
 void PreparedStatementBase::setInt64(const uint8 index, const int64 value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.i64 = value;
     statement_data[index].type = TYPE_I64;
 }
 
 void PreparedStatementBase::setFloat(const uint8 index, const float value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.f = value;
     statement_data[index].type = TYPE_FLOAT;
 }
 
 void PreparedStatementBase::setDouble(const uint8 index, const double value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].data.d = value;
     statement_data[index].type = TYPE_DOUBLE;
 }
 
 void PreparedStatementBase::setString(const uint8 index, const std::string& value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].binary.resize(value.length() + 1);
     memcpy(statement_data[index].binary.data(), value.c_str(), value.length() + 1);
     statement_data[index].type = TYPE_STRING;
@@ -176,14 +264,14 @@ void PreparedStatementBase::setString(const uint8 index, const std::string& valu
 
 void PreparedStatementBase::setBinary(const uint8 index, const std::vector<uint8>& value)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].binary = value;
     statement_data[index].type = TYPE_BINARY;
 }
 
 void PreparedStatementBase::setNull(const uint8 index)
 {
-    ASSERT(index < statement_data.size());
+    ASSERT(index < m_paramCount);
     statement_data[index].type = TYPE_NULL;
 }
 
@@ -203,6 +291,11 @@ PreparedStatementTask::~PreparedStatementTask()
         delete m_result;
 }
 
+bool PreparedStatementTask::IsBatchable() const
+{
+    return !m_has_result && m_conn && m_conn->CanBatchStatement(m_stmt->GetIndex());
+}
+
 bool PreparedStatementTask::Execute()
 {
     if (m_has_result)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "SQLOperation.h"
+#include "TrailingArrayPool.h"
 #include <future>
 #include <vector>
 
@@ -69,10 +70,15 @@ struct PreparedStatementData
     std::vector<uint8> binary;
 };
 
+//! Statements live in blocks of a pool per connection type, followed by their parameters
+typedef Trinity::TrailingArrayPool<PreparedStatementData> PreparedStatementPool;
+
 //- Forward declare
 class MySQLPreparedStatement;
 
 //- Upper-level class that is used in code
+//- Parameters are stored inline after the statement, which is why statements can only be created with
+//- new (pool, parameterCount) and are recycled instead of freed when deleted
 class TC_DATABASE_API PreparedStatementBase
 {
     friend class PreparedStatementTask;
@@ -83,6 +89,10 @@ class TC_DATABASE_API PreparedStatementBase
         explicit PreparedStatementBase(uint32 index, uint8 capacity);
         virtual ~PreparedStatementBase();
 
+        static void* operator new(std::size_t size, PreparedStatementPool& pool, uint8 capacity);
+        static void operator delete(void* ptr, PreparedStatementPool& pool, uint8 capacity);
+        static void operator delete(void* ptr);
+
         void setNull(uint8 index);
         void setBool(uint8 index, bool value);
         void setUInt8(uint8 index, uint8 value);
@@ -99,6 +109,9 @@ class TC_DATABASE_API PreparedStatementBase
         void setBinary(uint8 index, std::vector<uint8> const& value);
 
         uint32 GetIndex() const { return m_index; }
+        uint8 GetParameterCount() const { return m_paramCount; }
+        //! Hash of the statement index and all bound values, equal hashes mean the statement writes the same data
+        uint64 GetHash() const;
     protected:
         void BindParameters(MySQLPreparedStatement* stmt);
 
@@ -107,7 +120,8 @@ class TC_DATABASE_API PreparedStatementBase
         uint32 m_index;
 
         //- Buffer of parameters, not tied to MySQL in any way yet
-        std::vector<PreparedStatementData> statement_data;
+        PreparedStatementData* statement_data;
+        uint8 m_paramCount;
 
         PreparedStatementBase(PreparedStatementBase const& right) = delete;
         PreparedStatementBase& operator=(PreparedStatementBase const& right) = delete;
@@ -134,6 +148,7 @@ class TC_DATABASE_API PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute() override;
+        bool IsBatchable() const override;
         PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
     protected:
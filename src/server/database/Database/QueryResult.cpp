@@ -19,8 +19,10 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "MySQLConnection.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include "QuerySnapshot.h"
 
 namespace
 {
@@ -168,7 +170,10 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_streamConnection(nullptr),
+_snapshotRow(0),
+_error(false)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -179,6 +184,28 @@ _fields(fields)
     }
 }
 
+ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint32 fieldCount, MySQLConnection* connection) :
+ResultSet(result, fields, 0, fieldCount)
+{
+    _streamConnection = connection;
+}
+
+ResultSet::ResultSet(std::shared_ptr<QuerySnapshotEntry const> snapshot) :
+_fieldMetadata(snapshot->FieldMetadata),
+_rowCount(snapshot->RowCount),
+_fieldCount(uint32(snapshot->FieldMetadata.size())),
+_result(nullptr),
+_fields(nullptr),
+_streamConnection(nullptr),
+_snapshot(std::move(snapshot)),
+_snapshotRow(0),
+_error(false)
+{
+    _currentRow = new Field[_fieldCount];
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult*result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -325,12 +352,34 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshot)
+    {
+        if (_snapshotRow >= _rowCount)
+        {
+            CleanUp();
+            return false;
+        }
+
+        uint32 const* field = &_snapshot->Fields[_snapshotRow * _fieldCount * 2];
+        for (uint32 i = 0; i < _fieldCount; i++, field += 2)
+            _currentRow[i].SetStructuredValue(field[0] != QuerySnapshotEntry::NullValue ? &_snapshot->Values[field[0]] : nullptr, field[1]);
+
+        ++_snapshotRow;
+        return true;
+    }
+
     if (!_result)
         return false;
 
     row = mysql_fetch_row(_result);
     if (!row)
     {
+        if (_streamConnection && mysql_errno(_result->handle))
+        {
+            TC_LOG_ERROR("sql.sql", "%s:mysql_fetch_row, streamed result ended early. Error %s.", __FUNCTION__, mysql_error(_result->handle));
+            _error = true;
+        }
+
         CleanUp();
         return false;
     }
@@ -339,6 +388,7 @@ bool ResultSet::NextRow()
     if (!lengths)
     {
         TC_LOG_WARN("sql.sql", "%s:mysql_fetch_lengths, cannot retrieve value lengths. Error %s.", __FUNCTION__, mysql_error(_result->handle));
+        _error = true;
         CleanUp();
         return false;
     }
@@ -380,9 +430,18 @@ void ResultSet::CleanUp()
 
     if (_result)
     {
+        // for streamed results this also reads and drops rows that were not fetched yet
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    if (_streamConnection)
+    {
+        _streamConnection->Unlock();
+        _streamConnection = nullptr;
+    }
+
+    _snapshot.reset();
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -20,17 +20,29 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
+struct QuerySnapshotEntry;
+
+class MySQLConnection;
+
 class TC_DATABASE_API ResultSet
 {
     public:
         ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+        /// Reads rows from the server one at a time, the connection is unlocked once all rows were read.
+        /// The row count is not known up front, GetRowCount() returns 0.
+        ResultSet(MySQLResult* result, MySQLField* fields, uint32 fieldCount, MySQLConnection* connection);
+        /// Replays rows kept by a QuerySnapshot instead of reading them from MySQL
+        explicit ResultSet(std::shared_ptr<QuerySnapshotEntry const> snapshot);
         ~ResultSet();
 
         bool NextRow();
         uint64 GetRowCount() const { return _rowCount; }
         uint32 GetFieldCount() const { return _fieldCount; }
+        /// True once reading rows failed - for streamed results NextRow() returning false then does not mean all rows were read
+        bool HasError() const { return _error; }
 
         Field* Fetch() const { return _currentRow; }
         Field const& operator[](std::size_t index) const;
@@ -45,6 +57,10 @@ class TC_DATABASE_API ResultSet
         void CleanUp();
         MySQLResult* _result;
         MySQLField* _fields;
+        MySQLConnection* _streamConnection;
+        std::shared_ptr<QuerySnapshotEntry const> _snapshot;
+        uint64 _snapshotRow;
+        bool _error;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -0,0 +1,373 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "QuerySnapshot.h"
+#include "Errors.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "QueryResult.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+uint32 const SnapshotMagic = 0x53514354; // 'TCQS'
+uint32 const SnapshotVersion = 1;
+uint32 const MetadataStringsPerField = 5;
+
+class SnapshotReader
+{
+public:
+    SnapshotReader(uint8 const* data, std::size_t size) : _pos(data), _end(data + size) { }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (std::size_t(_end - _pos) < sizeof(T))
+            return false;
+
+        memcpy(&value, _pos, sizeof(T));
+        _pos += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool Read(std::vector<T>& values, uint64 count)
+    {
+        if (count > std::size_t(_end - _pos) / sizeof(T))
+            return false;
+
+        values.resize(std::size_t(count));
+        if (count)
+            memcpy(values.data(), _pos, std::size_t(count) * sizeof(T));
+        _pos += std::size_t(count) * sizeof(T);
+        return true;
+    }
+
+    bool Read(std::string& value)
+    {
+        uint32 length;
+        if (!Read(length) || length > std::size_t(_end - _pos))
+            return false;
+
+        value.assign(reinterpret_cast<char const*>(_pos), length);
+        _pos += length;
+        return true;
+    }
+
+    std::size_t GetRemaining() const { return std::size_t(_end - _pos); }
+
+private:
+    uint8 const* _pos;
+    uint8 const* _end;
+};
+
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(std::ofstream& stream) : _stream(stream) { }
+
+    template <typename T>
+    void Write(T const& value)
+    {
+        _stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void Write(std::vector<T> const& values)
+    {
+        if (!values.empty())
+            _stream.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(T));
+    }
+
+    void Write(std::string const& value)
+    {
+        Write(uint32(value.length()));
+        _stream.write(value.data(), value.length());
+    }
+
+private:
+    std::ofstream& _stream;
+};
+
+bool ReadEntry(SnapshotReader& reader, QuerySnapshotEntry& entry)
+{
+    uint32 fieldCount;
+    if (!reader.Read(entry.Sql) || !reader.Read(fieldCount) || !reader.Read(entry.RowCount))
+        return false;
+
+    // every field takes at least its string lengths and type, every value of a row an (offset, length) pair -
+    // counts that do not fit into the rest of the file are damage, checked before anything is allocated for them
+    std::size_t const minFieldMetadataSize = MetadataStringsPerField * sizeof(uint32) + sizeof(uint8);
+    if (fieldCount > reader.GetRemaining() / minFieldMetadataSize)
+        return false;
+
+    if (!fieldCount)
+    {
+        if (entry.RowCount)
+            return false;
+    }
+    else if (entry.RowCount > (reader.GetRemaining() - fieldCount * minFieldMetadataSize) / (uint64(fieldCount) * 2 * sizeof(uint32)))
+        return false;
+
+    entry.MetadataStrings.resize(fieldCount * MetadataStringsPerField);
+    entry.FieldMetadata.resize(fieldCount);
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        for (uint32 j = 0; j < MetadataStringsPerField; ++j)
+            if (!reader.Read(entry.MetadataStrings[i * MetadataStringsPerField + j]))
+                return false;
+
+        uint8 type;
+        if (!reader.Read(type) || type > uint8(DatabaseFieldTypes::Binary))
+            return false;
+
+        entry.FieldMetadata[i].Type = DatabaseFieldTypes(type);
+        entry.FieldMetadata[i].Index = i;
+    }
+
+    uint64 valuesSize;
+    if (!reader.Read(entry.Fields, entry.RowCount * fieldCount * 2) || !reader.Read(valuesSize) || !reader.Read(entry.Values, valuesSize))
+        return false;
+
+    // every value must lie within the value block, including its terminator
+    for (std::size_t i = 0; i < entry.Fields.size(); i += 2)
+        if (entry.Fields[i] != QuerySnapshotEntry::NullValue && uint64(entry.Fields[i]) + entry.Fields[i + 1] >= entry.Values.size())
+            return false;
+
+    entry.LinkMetadata();
+    return true;
+}
+
+void WriteEntry(SnapshotWriter& writer, QuerySnapshotEntry const& entry)
+{
+    writer.Write(entry.Sql);
+    writer.Write(uint32(entry.FieldMetadata.size()));
+    writer.Write(entry.RowCount);
+    for (uint32 i = 0; i < entry.FieldMetadata.size(); ++i)
+    {
+        for (uint32 j = 0; j < MetadataStringsPerField; ++j)
+            writer.Write(entry.MetadataStrings[i * MetadataStringsPerField + j]);
+
+        writer.Write(uint8(entry.FieldMetadata[i].Type));
+    }
+
+    writer.Write(entry.Fields);
+    writer.Write(uint64(entry.Values.size()));
+    writer.Write(entry.Values);
+}
+}
+
+void QuerySnapshotEntry::LinkMetadata()
+{
+    for (std::size_t i = 0; i < FieldMetadata.size(); ++i)
+    {
+        std::string const* strings = &MetadataStrings[i * MetadataStringsPerField];
+        FieldMetadata[i].TableName = strings[0].c_str();
+        FieldMetadata[i].TableAlias = strings[1].c_str();
+        FieldMetadata[i].Name = strings[2].c_str();
+        FieldMetadata[i].Alias = strings[3].c_str();
+        FieldMetadata[i].TypeName = strings[4].c_str();
+    }
+}
+
+QuerySnapshot::QuerySnapshot(std::string path, std::string state) : _path(std::move(path)), _state(std::move(state)), _replayed(0), _queried(0)
+{
+}
+
+bool QuerySnapshot::Load()
+{
+    Trinity::MappedFile file;
+    if (!file.Open(_path))
+        return false;
+
+    SnapshotReader reader(file.GetData(), file.GetSize());
+    uint32 magic, version, entryCount;
+    std::string state;
+    if (!reader.Read(magic) || magic != SnapshotMagic || !reader.Read(version) || version != SnapshotVersion)
+    {
+        TC_LOG_INFO("sql.sql", "Query snapshot %s was written by a different version, ignored.", _path.c_str());
+        return false;
+    }
+
+    if (!reader.Read(state) || state != _state)
+    {
+        TC_LOG_INFO("sql.sql", "Query snapshot %s was written for a different database state, ignored.", _path.c_str());
+        return false;
+    }
+
+    if (!reader.Read(entryCount))
+        return false;
+
+    std::unordered_map<std::string, std::shared_ptr<QuerySnapshotEntry const>> entries;
+    for (uint32 i = 0; i < entryCount; ++i)
+    {
+        std::shared_ptr<QuerySnapshotEntry> entry = std::make_shared<QuerySnapshotEntry>();
+        if (!ReadEntry(reader, *entry))
+        {
+            TC_LOG_ERROR("sql.sql", "Query snapshot %s is damaged, ignored.", _path.c_str());
+            return false;
+        }
+
+        std::string sql = entry->Sql;
+        entries[std::move(sql)] = std::move(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _entries = std::move(entries);
+    return true;
+}
+
+bool QuerySnapshot::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_queried)
+        return true;
+
+    std::string const tempPath = _path + ".tmp";
+    {
+        std::ofstream stream(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            TC_LOG_ERROR("sql.sql", "Could not write query snapshot %s.", tempPath.c_str());
+            return false;
+        }
+
+        SnapshotWriter writer(stream);
+        writer.Write(SnapshotMagic);
+        writer.Write(SnapshotVersion);
+        writer.Write(_state);
+        writer.Write(uint32(_used.size()));
+        for (auto const& used : _used)
+            WriteEntry(writer, *used.second);
+
+        if (!stream.flush())
+        {
+            TC_LOG_ERROR("sql.sql", "Could not write query snapshot %s.", tempPath.c_str());
+            stream.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    // only replace the previous snapshot once the new one is complete
+    std::remove(_path.c_str());
+    if (std::rename(tempPath.c_str(), _path.c_str()) != 0)
+    {
+        TC_LOG_ERROR("sql.sql", "Could not replace query snapshot %s.", _path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    _queried = 0;
+    return true;
+}
+
+bool QuerySnapshot::Replay(char const* sql, QueryResult& result)
+{
+    std::shared_ptr<QuerySnapshotEntry const> entry;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _entries.find(sql);
+        if (itr == _entries.end())
+            return false;
+
+        entry = itr->second;
+        _used[entry->Sql] = entry;
+        ++_replayed;
+    }
+
+    result = MakeResult(std::move(entry));
+    return true;
+}
+
+QueryResult QuerySnapshot::Capture(char const* sql, QueryResult result)
+{
+    std::shared_ptr<QuerySnapshotEntry> entry = std::make_shared<QuerySnapshotEntry>();
+    entry->Sql = sql;
+    if (result)
+    {
+        uint32 const fieldCount = result->GetFieldCount();
+        entry->MetadataStrings.resize(fieldCount * MetadataStringsPerField);
+        entry->FieldMetadata.resize(fieldCount);
+        entry->Fields.reserve(std::size_t(result->GetRowCount()) * fieldCount * 2);
+
+        Field const* fields = result->Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            QueryResultFieldMetadata const* meta = fields[i].meta;
+            char const* strings[MetadataStringsPerField] = { meta->TableName, meta->TableAlias, meta->Name, meta->Alias, meta->TypeName };
+            for (uint32 j = 0; j < MetadataStringsPerField; ++j)
+                entry->MetadataStrings[i * MetadataStringsPerField + j] = strings[j] ? strings[j] : "";
+
+            entry->FieldMetadata[i].Type = meta->Type;
+            entry->FieldMetadata[i].Index = i;
+        }
+
+        do
+        {
+            fields = result->Fetch();
+            for (uint32 i = 0; i < fieldCount; ++i)
+            {
+                if (!fields[i].data.value)
+                {
+                    entry->Fields.push_back(QuerySnapshotEntry::NullValue);
+                    entry->Fields.push_back(0);
+                    continue;
+                }
+
+                ASSERT(entry->Values.size() + fields[i].data.length < QuerySnapshotEntry::NullValue, "Query result too large for a snapshot: %s", sql);
+                entry->Fields.push_back(uint32(entry->Values.size()));
+                entry->Fields.push_back(fields[i].data.length);
+                entry->Values.insert(entry->Values.end(), fields[i].data.value, fields[i].data.value + fields[i].data.length);
+                entry->Values.push_back('\0');
+            }
+
+            ++entry->RowCount;
+        } while (result->NextRow());
+
+        // a streamed result that ended early must not be replayed as the full table
+        if (result->HasError())
+        {
+            TC_LOG_FATAL("sql.sql", "Reading rows for the query snapshot failed after " UI64FMTD " rows, aborting: %s", entry->RowCount, sql);
+            ABORT();
+        }
+
+        entry->LinkMetadata();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _used[entry->Sql] = entry;
+        ++_queried;
+    }
+
+    return MakeResult(std::move(entry));
+}
+
+QueryResult QuerySnapshot::MakeResult(std::shared_ptr<QuerySnapshotEntry const> entry)
+{
+    if (!entry->RowCount)
+        return QueryResult(nullptr);
+
+    // same contract as DatabaseWorkerPool::Query, the first row is already fetched
+    QueryResult result = std::make_shared<ResultSet>(std::move(entry));
+    result->NextRow();
+    return result;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef QuerySnapshot_h__
+#define QuerySnapshot_h__
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include "Field.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+template <class T>
+class DatabaseWorkerPool;
+
+/// Rows of one query kept in memory, every field is an (offset, length) pair into Values
+struct TC_DATABASE_API QuerySnapshotEntry
+{
+    static constexpr uint32 NullValue = 0xFFFFFFFF;
+
+    std::string Sql;
+    std::vector<std::string> MetadataStrings;               // table, table alias, name, alias and type name of every field
+    std::vector<QueryResultFieldMetadata> FieldMetadata;    // names point into MetadataStrings
+    std::vector<uint32> Fields;
+    std::vector<char> Values;                               // null terminated field values as returned by MySQL
+    uint64 RowCount = 0;
+
+    void LinkMetadata();
+};
+
+/**
+* File backed cache of plain query results. Results of queries run through it are written to disk
+* once the caller is done and replayed from the file on the next start, as long as it was written
+* for the same database state. Replayed results behave exactly like the ones MySQL returned,
+* loaders consuming them stay unchanged.
+*/
+class TC_DATABASE_API QuerySnapshot
+{
+public:
+    QuerySnapshot(std::string path, std::string state);
+
+    QuerySnapshot(QuerySnapshot const&) = delete;
+    QuerySnapshot& operator=(QuerySnapshot const&) = delete;
+
+    /// Reads the snapshot file, returns false when it is missing, damaged or written for a different state
+    bool Load();
+
+    /// Writes results used since Load if any of them had to be queried from the database
+    bool Save();
+
+    template <class T>
+    QueryResult Query(DatabaseWorkerPool<T>& pool, char const* sql)
+    {
+        QueryResult result;
+        if (Replay(sql, result))
+            return result;
+
+        // the result is copied into the snapshot right away, no need to buffer it in the client library first
+        return Capture(sql, pool.StreamQuery(sql));
+    }
+
+    uint32 GetReplayedCount() const { return _replayed; }
+    uint32 GetQueriedCount() const { return _queried; }
+
+private:
+    bool Replay(char const* sql, QueryResult& result);
+    QueryResult Capture(char const* sql, QueryResult result);
+
+    static QueryResult MakeResult(std::shared_ptr<QuerySnapshotEntry const> entry);
+
+    std::string _path;
+    std::string _state;
+
+    std::mutex _lock;
+    std::unordered_map<std::string, std::shared_ptr<QuerySnapshotEntry const>> _entries;
+    std::unordered_map<std::string, std::shared_ptr<QuerySnapshotEntry const>> _used;
+    uint32 _replayed;
+    uint32 _queried;
+};
+
+#endif // QuerySnapshot_h__
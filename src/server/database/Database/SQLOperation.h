@@ -20,6 +20,8 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <atomic>
+#include <chrono>
 
 //- Union that holds element data
 union SQLElementUnion
@@ -47,8 +49,12 @@ class MySQLConnection;
 class TC_DATABASE_API SQLOperation
 {
     public:
-        SQLOperation(): m_conn(nullptr) { }
-        virtual ~SQLOperation() { }
+        SQLOperation(): m_conn(nullptr), m_queueLoad(nullptr) { }
+        virtual ~SQLOperation()
+        {
+            if (m_queueLoad)
+                --*m_queueLoad;
+        }
 
         virtual int call()
         {
@@ -58,8 +64,22 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! Writes that can be committed together with other queued ones, results are only handed out once committed
+        virtual bool IsBatchable() const { return false; }
+        //! Number of statements sent to the server when executing
+        virtual uint32 GetStatementCount() const { return 1; }
+        //! Executes the operation inside a transaction opened by the worker
+        virtual bool ExecuteBatched() { return Execute(); }
+        //! Called once the transaction of the batch was committed
+        virtual void BatchCommitted() { }
+
         MySQLConnection* m_conn;
 
+        //! Time the operation was put into an async queue
+        std::chrono::steady_clock::time_point m_queueTime;
+        //! Operations waiting in or run from the async queue, counts this one until it is deleted
+        std::atomic<uint32>* m_queueLoad;
+
     private:
         SQLOperation(SQLOperation const& right) = delete;
         SQLOperation& operator=(SQLOperation const& right) = delete;
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQLOrderingKey_h__
+#define SQLOrderingKey_h__
+
+#include "Define.h"
+
+//! Selects the async queue an operation is executed from. Operations sharing a key always run on the
+//! same async connection in the order they were enqueued, operations with different keys may run in parallel.
+//! Operations without a key are spread over all async connections and have no ordering guarantees.
+struct SQLOrderingKey
+{
+    enum KeyType : uint8
+    {
+        KEY_NONE,
+        KEY_ACCOUNT,
+        KEY_GUILD
+    };
+
+    SQLOrderingKey() : Type(KEY_NONE), Id(0) { }
+    SQLOrderingKey(KeyType type, uint64 id) : Type(type), Id(id) { }
+
+    static SQLOrderingKey Account(uint32 accountId) { return { KEY_ACCOUNT, accountId }; }
+    static SQLOrderingKey Guild(uint32 guildId) { return { KEY_GUILD, guildId }; }
+
+    explicit operator bool() const { return Type != KEY_NONE; }
+
+    uint32 GetHash() const
+    {
+        uint64 hash = (Id ^ (uint64(Type) << 56)) * UI64LIT(0x9E3779B97F4A7C15);
+        return uint32(hash >> 32);
+    }
+
+    KeyType Type;
+    uint64 Id;
+};
+
+#endif // SQLOrderingKey_h__
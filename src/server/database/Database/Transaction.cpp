@@ -46,6 +46,48 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.push_back(data);
 }
 
+uint64 TransactionBase::GetHash(std::size_t first /*= 0*/) const
+{
+    uint64 hash = 0;
+    for (std::size_t i = first; i < m_queries.size(); ++i)
+    {
+        uint64 queryHash = 0;
+        switch (m_queries[i].type)
+        {
+            case SQL_ELEMENT_PREPARED:
+                queryHash = m_queries[i].element.stmt->GetHash();
+                break;
+            case SQL_ELEMENT_RAW:
+                queryHash = std::hash<std::string>()(m_queries[i].element.query);
+                break;
+        }
+
+        // order matters, a delete followed by an insert is not the same as the reverse
+        hash = (hash ^ queryHash) * UI64LIT(0x100000001B3) + i - first;
+    }
+
+    return hash;
+}
+
+void TransactionBase::Truncate(std::size_t size)
+{
+    for (std::size_t i = size; i < m_queries.size(); ++i)
+    {
+        switch (m_queries[i].type)
+        {
+            case SQL_ELEMENT_PREPARED:
+                delete m_queries[i].element.stmt;
+                break;
+            case SQL_ELEMENT_RAW:
+                free((void*)(m_queries[i].element.query));
+                break;
+        }
+    }
+
+    if (size < m_queries.size())
+        m_queries.resize(size);
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -105,6 +147,24 @@ bool TransactionTask::Execute()
     return false;
 }
 
+bool TransactionTask::IsBatchable() const
+{
+    if (!m_conn)
+        return false;
+
+    for (SQLElementData const& data : m_trans->m_queries)
+        if (data.type == SQL_ELEMENT_PREPARED && !m_conn->CanBatchStatement(data.element.stmt->GetIndex()))
+            return false;
+
+    return true;
+}
+
+bool TransactionTask::ExecuteBatched()
+{
+    // failures are retried by the worker through Execute once the batch is rolled back
+    return !m_conn->ExecuteTransactionStatements(m_trans);
+}
+
 int TransactionTask::TryExecute()
 {
     return m_conn->ExecuteTransaction(m_trans);
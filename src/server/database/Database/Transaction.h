@@ -48,6 +48,11 @@ class TC_DATABASE_API TransactionBase
 
         std::size_t GetSize() const { return m_queries.size(); }
 
+        //! Hash of the queries appended after the first ones, used to skip writing the same data again
+        uint64 GetHash(std::size_t first = 0) const;
+        //! Drops all queries appended after the first size ones
+        void Truncate(std::size_t size);
+
     protected:
         void AppendPreparedStatement(PreparedStatementBase* statement);
         void Cleanup();
@@ -80,8 +85,12 @@ class TC_DATABASE_API TransactionTask : public SQLOperation
         TransactionTask(std::shared_ptr<TransactionBase> trans) : m_trans(trans) { }
         ~TransactionTask() { }
 
+        bool IsBatchable() const override;
+        uint32 GetStatementCount() const override { return uint32(m_trans->GetSize()); }
+
     protected:
         bool Execute() override;
+        bool ExecuteBatched() override;
         int TryExecute();
         void CleanupOnFailure();
 
@@ -98,6 +107,7 @@ public:
 
 protected:
     bool Execute() override;
+    void BatchCommitted() override { m_result.set_value(true); }
 
     TransactionPromise m_result;
 };
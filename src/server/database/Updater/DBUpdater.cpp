@@ -23,6 +23,7 @@
 #include "GitRevision.h"
 #include "Log.h"
 #include "QueryResult.h"
+#include "SHA1.h"
 #include "StartProcess.h"
 #include "UpdateFetcher.h"
 #include <boost/filesystem/operations.hpp>
@@ -339,6 +340,25 @@ bool DBUpdater<T>::Populate(DatabaseWorkerPool<T>& pool)
     return true;
 }
 
+template<class T>
+std::string DBUpdater<T>::GetStateHash(DatabaseWorkerPool<T>& pool)
+{
+    QueryResult result = Retrieve(pool, "SELECT `name`, `hash` FROM `updates` ORDER BY `name` ASC");
+    if (!result)
+        return "";
+
+    std::string state;
+    do
+    {
+        Field* fields = result->Fetch();
+        state.append(fields[0].GetString()).push_back(':');
+        state.append(fields[1].GetString()).push_back('\n');
+    }
+    while (result->NextRow());
+
+    return CalculateSHA1Hash(state);
+}
+
 template<class T>
 QueryResult DBUpdater<T>::Retrieve(DatabaseWorkerPool<T>& pool, std::string const& query)
 {
@@ -84,6 +84,9 @@ public:
 
     static bool Populate(DatabaseWorkerPool<T>& pool);
 
+    /// Hash over the names and hashes of all applied updates, empty if the database has no update history
+    static std::string GetStateHash(DatabaseWorkerPool<T>& pool);
+
 private:
     static QueryResult Retrieve(DatabaseWorkerPool<T>& pool, std::string const& query);
     static void Apply(DatabaseWorkerPool<T>& pool, std::string const& query);
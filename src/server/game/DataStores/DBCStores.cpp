@@ -27,7 +27,11 @@
 #include "Regex.h"
 #include "SharedDefines.h"
 #include "SpellMgr.h"
+#include "ThreadPool.h"
 #include "Timer.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
 
  // temporary hack until includes are sorted out (don't want to pull in Windows.h)
 #ifdef GetClassName
@@ -267,7 +271,7 @@ PhaseGroupContainer sPhasesByGroup;
 
 typedef std::list<std::string> StoreProblemList;
 
-uint32 DBCFileCount = 0;
+std::atomic<uint32> DBCFileCount(0);
 
 DBCManager& DBCManager::Instance()
 {
@@ -289,7 +293,7 @@ namespace
 }
 
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, uint32 defaultLocale, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
+inline void LoadDBC(std::atomic<uint32>& availableDbcLocales, StoreProblemList& errors, std::mutex& errorsLock, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, uint32 defaultLocale, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
 {
     // compatibility format and C++ structure sizes
     ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
@@ -310,7 +314,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             localizedName.append(filename);
 
             if (!storage.LoadStringsFrom(localizedName.c_str()))
-                availableDbcLocales &= ~(1 << i);             // mark as not available for speedup next checks
+                availableDbcLocales.fetch_and(~(1 << i));     // mark as not available for speedup next checks
         }
 
         if (!customFormat.empty())
@@ -319,6 +323,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     else
     {
         // sort problematic dbc to (1) non compatible and (2) non-existed
+        std::lock_guard<std::mutex> lock(errorsLock);
         if (FILE* f = fopen(dbcFilename.c_str(), "rb"))
         {
             std::ostringstream stream;
@@ -332,14 +337,15 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     }
 }
 
-void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
+void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale, uint32 threads)
 {
     uint32 oldMSTime = getMSTime();
 
     std::string dbcPath = dataPath + "dbc/";
 
     StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
+    std::mutex badDbcFilesLock;
+    std::atomic<uint32> availableDbcLocales(0xFFFFFFFF);
 
     // Local DBCs (used only to load some internal storage)
     DBCStorage<MapDifficultyEntry> sMapDifficultyStore(MapDifficultyEntryfmt);
@@ -349,7 +355,20 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
     DBCStorage<PhaseGroupEntry> sPhaseGroupStore(PhaseGroupfmt);
     DBCStorage<TalentTreePrimarySpellsEntry> sTalentTreePrimarySpellsStore(TalentTreePrimarySpellsfmt);
 
-#define LOAD_DBC(store, file) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, defaultLocale)
+    // stores do not depend on each other, only the post processing below needs them all
+    std::unique_ptr<Trinity::ThreadPool> loaderPool;
+    if (threads > 1)
+        loaderPool = std::make_unique<Trinity::ThreadPool>(threads);
+
+    auto queueLoad = [&loaderPool](std::function<void()>&& load)
+    {
+        if (loaderPool)
+            loaderPool->PostWork(std::move(load));
+        else
+            load();
+    };
+
+#define LOAD_DBC(store, file) queueLoad([&]() { LoadDBC(availableDbcLocales, bad_dbc_files, badDbcFilesLock, store, dbcPath, file, defaultLocale); })
 
     LOAD_DBC(sAreaTableStore,                     "AreaTable.dbc");
     LOAD_DBC(sAnimKitStore,                       "AnimKit.dbc");//15595
@@ -520,7 +539,7 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
 
 #undef LOAD_DBC
 
-#define LOAD_DBC_EXT(store, file, dbformat, dbpk) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, defaultLocale, dbformat, dbpk)
+#define LOAD_DBC_EXT(store, file, dbformat, dbpk) queueLoad([&]() { LoadDBC(availableDbcLocales, bad_dbc_files, badDbcFilesLock, store, dbcPath, file, defaultLocale, dbformat, dbpk); })
 
     LOAD_DBC_EXT(sAchievementStore,     "Achievement.dbc",     CustomAchievementfmt,      CustomAchievementIndex);//15595
     LOAD_DBC_EXT(sSpellStore,           "Spell.dbc",           CustomSpellEntryfmt,       CustomSpellEntryIndex);//
@@ -529,6 +548,12 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
 
 #undef LOAD_DBC_EXT
 
+    if (loaderPool)
+        loaderPool->Join();
+
+    // workers finish in any order
+    bad_dbc_files.sort();
+
     for (CharStartOutfitEntry const* outfit : sCharStartOutfitStore)
         sCharStartOutfitMap[outfit->RaceID | (outfit->ClassID << 8) | (outfit->SexID << 16)] = outfit;
 
@@ -789,7 +814,7 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
     // error checks
     if (bad_dbc_files.size() >= DBCFileCount)
     {
-        TC_LOG_ERROR("misc", "Incorrect DataDir value in worldserver.conf or ALL required *.dbc files (%d) not found by path: %sdbc/%s", DBCFileCount, dataPath.c_str(), localeNames[defaultLocale]);
+        TC_LOG_ERROR("misc", "Incorrect DataDir value in worldserver.conf or ALL required *.dbc files (%d) not found by path: %sdbc/%s", DBCFileCount.load(), dataPath.c_str(), localeNames[defaultLocale]);
         exit(1);
     }
     else if (!bad_dbc_files.empty())
@@ -798,7 +823,7 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
         for (StoreProblemList::iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
             str += *i + "\n";
 
-        TC_LOG_ERROR("misc", "Some required *.dbc files (%u from %d) not found or not compatible:\n%s", (uint32)bad_dbc_files.size(), DBCFileCount, str.c_str());
+        TC_LOG_ERROR("misc", "Some required *.dbc files (%u from %d) not found or not compatible:\n%s", (uint32)bad_dbc_files.size(), DBCFileCount.load(), str.c_str());
         exit(1);
     }
 
@@ -813,7 +838,7 @@ void DBCManager::LoadStores(const std::string& dataPath, uint32 defaultLocale)
         exit(1);
     }
 
-    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores in %u ms", DBCFileCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores in %u ms", DBCFileCount.load(), GetMSTimeDiffToNow(oldMSTime));
 }
 
 std::string const& DBCManager::GetRandomCharacterName(uint8 race, uint8 gender)
@@ -1388,6 +1388,7 @@ void Creature::SaveToDB(uint32 mapid, uint8 spawnMask)
     trans->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans);
+    sObjectMgr->InvalidateWorldDataSnapshot();
 }
 
 void Creature::SelectLevel()
@@ -1780,6 +1781,7 @@ bool Creature::hasInvolvedQuest(uint32 quest_id) const
     trans2->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans2);
+    sObjectMgr->InvalidateWorldDataSnapshot();
 
     return true;
 }
@@ -2040,7 +2042,7 @@ void Creature::Respawn(bool force)
 
             uint32 poolid = GetCreatureData() ? GetCreatureData()->poolId : 0;
             if (poolid)
-                sPoolMgr->UpdatePool<Creature>(GetMap()->GetPoolData(), poolid, GetSpawnId());
+                GetMap()->ExecuteAfterIslandUpdate([map = GetMap(), poolid, spawnId = GetSpawnId()]() { sPoolMgr->UpdatePool<Creature>(map->GetPoolData(), poolid, spawnId); });
         }
         UpdateObjectVisibility();
     }
@@ -953,7 +953,7 @@ void GameObject::Update(uint32 diff)
                         // Respawn timer
                         uint32 poolid = GetGameObjectData() ? GetGameObjectData()->poolId : 0;
                         if (poolid)
-                            sPoolMgr->UpdatePool<GameObject>(GetMap()->GetPoolData(), poolid, GetSpawnId());
+                            GetMap()->ExecuteAfterIslandUpdate([map = GetMap(), poolid, spawnId = GetSpawnId()]() { sPoolMgr->UpdatePool<GameObject>(map->GetPoolData(), poolid, spawnId); });
                         else
                             GetMap()->AddToMap(this);
                     }
@@ -1249,7 +1249,7 @@ void GameObject::Delete()
 
     uint32 poolid = GetGameObjectData() ? GetGameObjectData()->poolId : 0;
     if (poolid)
-        sPoolMgr->UpdatePool<GameObject>(GetMap()->GetPoolData(), poolid, GetSpawnId());
+        GetMap()->ExecuteAfterIslandUpdate([map = GetMap(), poolid, spawnId = GetSpawnId()]() { sPoolMgr->UpdatePool<GameObject>(map->GetPoolData(), poolid, spawnId); });
     else
         AddObjectToRemoveList();
 }
@@ -1379,6 +1379,7 @@ void GameObject::SaveToDB(uint32 mapid, uint8 spawnMask)
     trans->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans);
+    sObjectMgr->InvalidateWorldDataSnapshot();
 }
 
 bool GameObject::LoadFromDB(ObjectGuid::LowType spawnId, Map* map, bool addToMap, bool)
@@ -1488,6 +1489,7 @@ bool GameObject::LoadFromDB(ObjectGuid::LowType spawnId, Map* map, bool addToMap
     trans2->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans2);
+    sObjectMgr->InvalidateWorldDataSnapshot();
 
     return true;
 }
@@ -2758,6 +2760,9 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->InsertGameObjectModel(*m_model);*/
 
     m_model->enableCollision(enable);
+
+    if (IsInWorld())
+        GetMap()->InvalidateGameObjectModelQueries();
 }
 
 void GameObject::UpdateModel()
@@ -2853,62 +2858,59 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    updateMask.SelectFields(updateType == UPDATETYPE_VALUES, _changesMask, m_uint32Values, UpdateFieldVisibility::Get(flags), visibleFlag, _fieldNotifyFlags);
+    if (forcedFlags)
+        updateMask.SetBit(GAMEOBJECT_FLAGS);
+
+    for (uint32 index : updateMask)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == GAMEOBJECT_FLAGS && forcedFlags))
+        if (index == GAMEOBJECT_DYNAMIC)
         {
-            updateMask.SetBit(index);
+            uint32 dynamicFlags = m_uint32Values[GAMEOBJECT_DYNAMIC];
 
-            if (index == GAMEOBJECT_DYNAMIC)
+            uint16 dynFlags = 0;
+            uint16 pathProgress = 0xFFFF;
+            switch (GetGoType())
             {
-                uint32 dynamicFlags = m_uint32Values[GAMEOBJECT_DYNAMIC];
-
-                uint16 dynFlags = 0;
-                uint16 pathProgress = 0xFFFF;
-                switch (GetGoType())
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    else if (targetIsGM)
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_TRANSPORT:
+                case GAMEOBJECT_TYPE_MO_TRANSPORT:
                 {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                    {
-                        dynFlags = dynamicFlags & 0xFFFF;
-                        pathProgress = dynamicFlags >> 16;
-                        break;
-                    }
-                    default:
-                        break;
+                    dynFlags = dynamicFlags & 0xFFFF;
+                    pathProgress = dynamicFlags >> 16;
+                    break;
                 }
-
-                fieldBuffer << ((uint32(pathProgress) << 16) | uint32(dynFlags));
+                default:
+                    break;
             }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
-                        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
 
-                fieldBuffer << goFlags;
-            }
-            else
-                fieldBuffer << m_uint32Values[index];                // other cases
+            fieldBuffer << ((uint32(pathProgress) << 16) | uint32(dynFlags));
         }
+        else if (index == GAMEOBJECT_FLAGS)
+        {
+            uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
+                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+            fieldBuffer << goFlags;
+        }
+        else
+            fieldBuffer << m_uint32Values[index];                // other cases
     }
 
     updateMask.AppendToPacket(data);
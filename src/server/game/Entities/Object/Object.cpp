@@ -86,6 +86,7 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
     m_isNewObject       = false;
     m_isDestroyedObject = false;
     m_objectUpdated     = false;
+    m_updateObjectIndex = 0;
 }
 
 WorldObject::~WorldObject()
@@ -674,15 +675,9 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+    updateMask.SelectFields(updateType == UPDATETYPE_VALUES, _changesMask, m_uint32Values, UpdateFieldVisibility::Get(flags), visibleFlag, _fieldNotifyFlags);
+    for (uint32 index : updateMask)
+        fieldBuffer << m_uint32Values[index];
 
     updateMask.AppendToPacket(data);
     data->append(fieldBuffer);
@@ -1376,22 +1371,30 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-
-        return GetMap()->isInLineOfSight(GetPhaseShift(), x, y, z, ox, oy, oz, checks, ignoreFlags);
+        Position start, end;
+        GetLineOfSightSegment(ox, oy, oz, start, end);
+        return GetMap()->isInLineOfSight(GetPhaseShift(), start.GetPositionX(), start.GetPositionY(), start.GetPositionZ(), end.GetPositionX(), end.GetPositionY(), end.GetPositionZ(), checks, ignoreFlags);
     }
 
     return true;
 }
 
+void WorldObject::GetLineOfSightSegment(float ox, float oy, float oz, Position& start, Position& end) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+
+    start.Relocate(x, y, z);
+    end.Relocate(ox, oy, oz);
+}
+
 bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!IsInMap(obj))
@@ -228,6 +228,11 @@ class TC_GAME_API Object
         bool m_objectUpdated;
 
     private:
+        friend class Map;
+
+        // position in Map::_updateObjects while m_objectUpdated is set
+        std::size_t m_updateObjectIndex;
+
         bool m_inWorld;
         bool m_isNewObject;
         bool m_isDestroyedObject;
@@ -359,6 +364,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D = true) const;
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // start and end of the segment IsWithinLOS checks towards the given point
+        void GetLineOfSightSegment(float x, float y, float z, Position& start, Position& end) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
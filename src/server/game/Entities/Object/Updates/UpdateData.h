@@ -71,6 +71,8 @@ class UpdateData
         void AddUpdateBlock(const ByteBuffer &block);
         bool BuildPacket(WorldPacket* packet);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
+        void Reserve(std::size_t size) { m_data.reserve(size); }
+        std::size_t GetDataSize() const { return m_data.size(); }
         void Clear();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
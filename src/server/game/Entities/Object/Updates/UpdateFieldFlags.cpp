@@ -16,6 +16,7 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "Errors.h"
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -1656,3 +1657,39 @@ uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END] =
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+1
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+2
 };
+
+UpdateFieldVisibility::UpdateFieldVisibility(uint32 const* flags, uint32 fieldCount) : _blockCount((fieldCount + 31) / 32)
+{
+    _masks.resize(FlagCombinations * _blockCount, 0);
+    for (uint32 combination = 0; combination < FlagCombinations; ++combination)
+    {
+        uint32* mask = &_masks[combination * _blockCount];
+        for (uint32 index = 0; index < fieldCount; ++index)
+            if (flags[index] & combination)
+                mask[index / 32] |= 1u << (index % 32);
+    }
+}
+
+UpdateFieldVisibility const& UpdateFieldVisibility::Get(uint32 const* flags)
+{
+    static UpdateFieldVisibility const item(ItemUpdateFieldFlags, CONTAINER_END);
+    static UpdateFieldVisibility const unit(UnitUpdateFieldFlags, PLAYER_END);
+    static UpdateFieldVisibility const gameObject(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    static UpdateFieldVisibility const dynamicObject(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    static UpdateFieldVisibility const corpse(CorpseUpdateFieldFlags, CORPSE_END);
+    static UpdateFieldVisibility const areaTrigger(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
+
+    if (flags == ItemUpdateFieldFlags)
+        return item;
+    if (flags == UnitUpdateFieldFlags)
+        return unit;
+    if (flags == GameObjectUpdateFieldFlags)
+        return gameObject;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return dynamicObject;
+    if (flags == CorpseUpdateFieldFlags)
+        return corpse;
+
+    ASSERT(flags == AreaTriggerUpdateFieldFlags);
+    return areaTrigger;
+}
@@ -20,6 +20,7 @@
 
 #include "UpdateFields.h"
 #include "Define.h"
+#include <vector>
 
 enum UpdatefieldFlags
 {
@@ -42,4 +43,24 @@ TC_GAME_API extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 TC_GAME_API extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 TC_GAME_API extern uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END];
 
+/// Bitmasks (in client update mask blocks) of the fields of one object type that are visible
+/// for every combination of UF_FLAG_* bits, built once instead of testing field flags per update
+class TC_GAME_API UpdateFieldVisibility
+{
+public:
+    static uint32 constexpr FlagCombinations = UF_FLAG_DYNAMIC << 1;
+
+    UpdateFieldVisibility(uint32 const* flags, uint32 fieldCount);
+
+    /// Fields having any of the given flags
+    uint32 const* GetMask(uint32 flags) const { return &_masks[(flags & (FlagCombinations - 1)) * _blockCount]; }
+
+    /// Visibility table of one of the *UpdateFieldFlags arrays
+    static UpdateFieldVisibility const& Get(uint32 const* flags);
+
+private:
+    uint32 _blockCount;
+    std::vector<uint32> _masks;
+};
+
 #endif // _UPDATEFIELDFLAGS_H
@@ -19,45 +19,53 @@
 #define __UPDATEMASK_H
 
 #include "UpdateFields.h"
+#include "UpdateFieldFlags.h"
 #include "Errors.h"
 #include "ByteBuffer.h"
+#include "UpdateMaskBits.h"
+#include <algorithm>
+#include <array>
+#include <memory>
 
+/// Fields changed since the last object update, one bit per field
 class UpdateMask
 {
 public:
-    UpdateMask() : _bits(nullptr), _fieldCount(0) { }
+    UpdateMask() : _blocks(nullptr), _blockCount(0) { }
 
     void SetBit(uint32 index)
     {
-        _bits[index] = 1;
+        _blocks[index / 32] |= 1u << (index % 32);
     }
 
     void UnsetBit(uint32 index)
     {
-        _bits[index] = 0;
+        _blocks[index / 32] &= ~(1u << (index % 32));
     }
 
     bool GetBit(uint32 index) const
     {
-        return _bits[index] != 0;
+        return (_blocks[index / 32] & (1u << (index % 32))) != 0;
     }
 
+    uint32 const* GetBlocks() const { return _blocks.get(); }
+
     void SetCount(uint32 valuesCount)
     {
-        _bits = std::make_unique<uint8[]>(valuesCount);
-        std::uninitialized_fill_n(&_bits[0], valuesCount, 0);
-        _fieldCount = valuesCount;
+        _blockCount = UpdateMaskBits::CalculateBlockCount(valuesCount);
+        _blocks = std::make_unique<uint32[]>(_blockCount);
+        std::uninitialized_fill_n(&_blocks[0], _blockCount, 0);
     }
 
     void Clear()
     {
-        if (_bits)
-            std::fill_n(&_bits[0], _fieldCount, 0);
+        if (_blocks)
+            std::fill_n(&_blocks[0], _blockCount, 0);
     }
 
 private:
-    std::unique_ptr<uint8[]> _bits;
-    uint32 _fieldCount;
+    std::unique_ptr<uint32[]> _blocks;
+    uint32 _blockCount;
 };
 
 class UpdateMaskPacketBuilder
@@ -71,25 +79,50 @@ public:
         CLIENT_UPDATE_MASK_BITS = sizeof(ClientUpdateMaskType) * 8,
     };
 
-    explicit UpdateMaskPacketBuilder(uint32 valuesCount) : _lastSetBit(0)
+    /// Iterates over set bits in ascending order
+    class const_iterator
+    {
+    public:
+        const_iterator(UpdateMaskPacketBuilder const* mask, uint32 index) : _mask(mask), _index(index) { }
+
+        uint32 operator*() const { return _index; }
+        const_iterator& operator++() { _index = _mask->FindNextBit(_index + 1); return *this; }
+        bool operator!=(const_iterator const& right) const { return _index != right._index; }
+
+    private:
+        UpdateMaskPacketBuilder const* _mask;
+        uint32 _index;
+    };
+
+    // mask lives on the stack, sized for the largest object type (players)
+    explicit UpdateMaskPacketBuilder(uint32 valuesCount) : _valuesCount(valuesCount), _blockCount(CalculateBlockCount(valuesCount))
     {
-        std::size_t blockCount = CalculateBlockCount(valuesCount);
-        _mask = std::make_unique<ClientUpdateMaskType[]>(blockCount);
-        std::uninitialized_fill_n(&_mask[0], blockCount, 0);
+        ASSERT(_blockCount <= _mask.size());
+        std::fill_n(_mask.begin(), _blockCount, 0);
     }
 
     void SetBit(uint32 bit)
     {
         _mask[GetBlockIndex(bit)] |= GetBlockFlag(bit);
-        _lastSetBit = bit;
     }
 
+    /// Marks the fields an update for a receiver carries: fields with any of notifyFlags, plus visible fields
+    /// that changed (values update) or are non-zero (create update)
+    void SelectFields(bool valuesUpdate, UpdateMask const& changes, uint32 const* values, UpdateFieldVisibility const& visibility,
+        uint32 visibleFlag, uint32 notifyFlags)
+    {
+        UpdateMaskBits::SelectFields(_mask.data(), _valuesCount, valuesUpdate, changes.GetBlocks(), values, visibility.GetMask(visibleFlag),
+            visibility.GetMask(notifyFlags));
+    }
+
+    const_iterator begin() const { return const_iterator(this, FindNextBit(0)); }
+    const_iterator end() const { return const_iterator(this, _valuesCount); }
+
     void AppendToPacket(ByteBuffer* data)
     {
-        uint8 blockCount = CalculateBlockCount(_lastSetBit + 1);
+        uint8 blockCount = UpdateMaskBits::CountUsedBlocks(_mask.data(), _blockCount);
         *data << uint8(blockCount);
-        if (blockCount)
-            data->append(&_mask[0], blockCount);
+        data->append(&_mask[0], blockCount);
     }
 
 private:
@@ -108,8 +141,24 @@ private:
         return 1u << (bit % 32);
     }
 
-    std::unique_ptr<ClientUpdateMaskType[]> _mask;
-    uint32 _lastSetBit;
+    uint32 FindNextBit(uint32 index) const
+    {
+        for (uint32 block = GetBlockIndex(index); block < _blockCount; ++block)
+        {
+            uint32 bits = _mask[block];
+            if (block == GetBlockIndex(index))
+                bits &= ~(GetBlockFlag(index) - 1);
+
+            if (bits)
+                return block * CLIENT_UPDATE_MASK_BITS + UpdateMaskBits::CountTrailingZeros(bits);
+        }
+
+        return _valuesCount;
+    }
+
+    std::array<ClientUpdateMaskType, UpdateMaskBits::CalculateBlockCount(PLAYER_END)> _mask;
+    uint32 _valuesCount;
+    uint8 _blockCount;
 };
 
 #endif
@@ -183,6 +183,7 @@ Player::Player(WorldSession* session): Unit(true)
     m_needsZoneUpdate = false;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_saveId = 0;
 
     _resurrectionData = nullptr;
 
@@ -2362,7 +2363,7 @@ void Player::GiveLevel(uint8 level)
         /// @todo Poor design of mail system
         CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
         MailDraft(mailReward->mailTemplateId).SendMailTo(trans, this, MailSender(MAIL_CREATURE, mailReward->senderEntry));
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
     }
 
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL);
@@ -3542,7 +3543,7 @@ bool Player::ResetTalents(bool no_cost)
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     _SaveTalents(trans);
     _SaveSpells(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 
     if (!no_cost)
     {
@@ -4013,11 +4014,11 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
                 playerguid.ToString().c_str(), charDelete_method);
 
             if (trans->GetSize() > 0)
-                CharacterDatabase.CommitTransaction(trans);
+                CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(accountId));
             return;
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(accountId));
 
     if (updateRealmChars)
         sWorld->UpdateRealmCharCount(accountId);
@@ -14443,7 +14444,7 @@ void Player::RewardQuest(Quest const* quest, uint32 reward, Object* questGiver,
             MailDraft(mail_template_id).SendMailTo(trans, this, questMailSender, MAIL_CHECK_MASK_HAS_BODY, quest->GetRewMailDelaySecs());
         else
             MailDraft(mail_template_id).SendMailTo(trans, this, questGiver, MAIL_CHECK_MASK_HAS_BODY, quest->GetRewMailDelaySecs());
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
     }
 
     if (quest->IsDaily() && !quest->IsDFQuest())
@@ -17546,7 +17547,7 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
             }
             draft.SendMailTo(trans, this, MailSender(this, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
         }
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
     }
     //if (IsAlive())
     _ApplyAllItemMods();
@@ -18824,7 +18825,14 @@ void Player::SaveToDB(bool create /*=false*/)
 
     SaveToDB(trans, create);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // parts only count as saved once the transaction is committed, other callers of SaveToDB(trans) never confirm theirs
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId())))
+        .AfterComplete([session = GetSession(), guid = GetGUID(), saveId = m_saveId](bool success)
+    {
+        if (Player* player = session->GetPlayer())
+            if (player->GetGUID() == guid)
+                player->_OnSaveCommitted(saveId, success);
+    });
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false */)
@@ -18851,9 +18859,13 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
     CharacterDatabasePreparedStatement* stmt = nullptr;
     uint8 index = 0;
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_FISHINGSTEPS);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    // a new character has nothing in the database yet
+    if (create)
+        m_savedPartHashes.clear();
+
+    // unique across players, a callback of a logged out character must not match a save of the next one
+    static std::atomic<uint32> nextSaveId(1);
+    m_saveId = nextSaveId++;
 
     auto finiteAlways = [](float f) { return std::isfinite(f) ? f : 0.0f; };
 
@@ -19123,6 +19135,11 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
 
     trans->Append(stmt);
 
+    std::size_t first = trans->GetSize();
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_FISHINGSTEPS);
+    stmt->setUInt32(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
     if (m_fishingSteps != 0)
     {
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_FISHINGSTEPS);
@@ -19131,11 +19148,14 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
         stmt->setUInt32(index++, m_fishingSteps);
         trans->Append(stmt);
     }
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_FISHING_STEPS);
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
 
+    first = trans->GetSize();
     _SaveBGData(trans);
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_BG_DATA);
     _SaveInventory(trans);
     _SaveVoidStorage(trans);
     _SaveQuestStatus(trans);
@@ -19146,23 +19166,35 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
     _SaveLFGRewardStatus(trans);
     _SaveTalents(trans);
     _SaveSpells(trans);
+    first = trans->GetSize();
     GetSpellHistory()->SaveToDB<Player>(trans);
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_SPELL_HISTORY);
     _SaveActions(trans);
+    first = trans->GetSize();
     _SaveAuras(trans);
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_AURAS);
     _SaveSkills(trans);
     m_achievementMgr->SaveToDB(trans);
     m_reputationMgr->SaveToDB(trans);
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
+    first = trans->GetSize();
     _SaveGlyphs(trans);
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_GLYPHS);
+    first = trans->GetSize();
     _SaveInstanceTimeRestrictions(trans);
+    _SkipUnchangedSave(trans, first, PLAYER_SAVE_INSTANCE_TIME_RESTRICTIONS);
     _SaveCurrency(trans);
     _SaveCUFProfiles(trans);
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
+    {
+        first = trans->GetSize();
         _SaveStats(trans);
+        _SkipUnchangedSave(trans, first, PLAYER_SAVE_STATS);
+    }
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -19461,7 +19493,9 @@ void Player::_SaveVoidStorage(CharacterDatabaseTransaction& trans)
             stmt->setUInt32(7, _voidStorageItems[i]->ItemSuffixFactor);
         }
 
+        std::size_t first = trans->GetSize();
         trans->Append(stmt);
+        _SkipUnchangedSave(trans, first, PLAYER_SAVE_VOID_STORAGE_SLOT, i);
     }
 }
 
@@ -19499,7 +19533,56 @@ void Player::_SaveCUFProfiles(CharacterDatabaseTransaction& trans)
             stmt->setUInt16(13, _CUFProfiles[i]->LeftOffset);
         }
 
+        std::size_t first = trans->GetSize();
         trans->Append(stmt);
+        _SkipUnchangedSave(trans, first, PLAYER_SAVE_CUF_PROFILE, i);
+    }
+}
+
+// Drops the statements appended since first if they are exactly what was written for this part by the previous save
+void Player::_SkipUnchangedSave(CharacterDatabaseTransaction& trans, std::size_t first, PlayerSavePart part, uint32 index /*= 0*/)
+{
+    if (!sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_SKIP_UNCHANGED))
+    {
+        // hashes would be stale if it gets enabled again by a config reload
+        m_savedPartHashes.clear();
+        m_unsavedPartHashes.clear();
+        return;
+    }
+
+    uint32 key = uint32(part) << 16 | index;
+    uint64 hash = trans->GetHash(first);
+    auto itr = m_savedPartHashes.find(key);
+    if (itr != m_savedPartHashes.end())
+    {
+        if (itr->second == hash)
+        {
+            trans->Truncate(first);
+            return;
+        }
+
+        // the database holds either the old or the new statements until the commit is confirmed
+        m_savedPartHashes.erase(itr);
+    }
+
+    m_unsavedPartHashes[key] = { m_saveId, hash };
+}
+
+void Player::_OnSaveCommitted(uint32 saveId, bool success)
+{
+    // parts written again by a later save wait for that one
+    for (auto itr = m_unsavedPartHashes.begin(); itr != m_unsavedPartHashes.end();)
+    {
+        if (itr->second.first != saveId)
+        {
+            ++itr;
+            continue;
+        }
+
+        if (success && sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_SKIP_UNCHANGED))
+            m_savedPartHashes[itr->first] = itr->second.second;
+
+        itr = m_unsavedPartHashes.erase(itr);
     }
 }
 
@@ -19645,7 +19728,7 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction& trans)
     m_RewardedQuestsSave.clear();
 
     if (!isTransaction)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 }
 
 void Player::_SaveDailyQuestStatus(CharacterDatabaseTransaction& trans)
@@ -23801,7 +23884,7 @@ void Player::AutoUnequipOffhandIfNeed(bool force /*= false*/)
         std::string subject = GetSession()->GetTrinityString(LANG_NOT_EQUIPPED_ITEM);
         MailDraft(subject, "There were problems with equipping one or several items").AddItem(offItem).SendMailTo(trans, this, MailSender(this, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
 
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
     }
 }
 
@@ -26210,7 +26293,7 @@ void Player::UpdateSpecCount(uint8 count)
 
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 
     SetSpecsCount(count);
 
@@ -26230,7 +26313,7 @@ void Player::ActivateSpec(uint8 spec)
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     _SaveActions(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 
     // TO-DO: We need more research to know what happens with warlock's reagent
     if (Pet* pet = GetPet())
@@ -26711,7 +26794,7 @@ void Player::RefundItem(Item* item)
 
     SaveInventoryAndGoldToDB(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 }
 
 void Player::SendItemRetrievalMail(uint32 itemEntry, uint32 count)
@@ -26727,7 +26810,7 @@ void Player::SendItemRetrievalMail(uint32 itemEntry, uint32 count)
     }
 
     draft.SendMailTo(trans, MailReceiver(this, GetGUID().GetCounter()), sender);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetSession()->GetAccountId()));
 }
 
 void Player::SetRandomWinner(bool isWinner)
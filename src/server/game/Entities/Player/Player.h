@@ -811,6 +811,20 @@ enum PlayerDelayedOperations
     DELAYED_END
 };
 
+// Parts of the character that are rewritten as a whole on every save, skipped when they would write the same rows again
+enum PlayerSavePart
+{
+    PLAYER_SAVE_FISHING_STEPS,
+    PLAYER_SAVE_BG_DATA,
+    PLAYER_SAVE_VOID_STORAGE_SLOT,                          ///< per slot
+    PLAYER_SAVE_SPELL_HISTORY,
+    PLAYER_SAVE_AURAS,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_INSTANCE_TIME_RESTRICTIONS,
+    PLAYER_SAVE_CUF_PROFILE,                                ///< per profile
+    PLAYER_SAVE_STATS
+};
+
 // Player summoning auto-decline time (in secs)
 #define MAX_PLAYER_SUMMON_DELAY                   (2*MINUTE)
 // Maximum money amount : 2^31 - 1
@@ -2502,6 +2516,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _SaveCurrency(CharacterDatabaseTransaction& trans);
         void _SaveCUFProfiles(CharacterDatabaseTransaction& trans);
         void _SaveLFGRewardStatus(CharacterDatabaseTransaction& trans);
+        void _SkipUnchangedSave(CharacterDatabaseTransaction& trans, std::size_t first, PlayerSavePart part, uint32 index = 0);
+        void _OnSaveCommitted(uint32 saveId, bool success);
 
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -2522,6 +2538,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         uint32 m_team;
         uint32 m_nextSave;
+        std::unordered_map<uint32, uint64> m_savedPartHashes;  // hash of the statements last committed per PlayerSavePart (and index)
+        std::unordered_map<uint32, std::pair<uint32, uint64>> m_unsavedPartHashes; // save id and hash of statements whose commit is not confirmed yet
+        uint32 m_saveId;                                        // identifies the current save in m_unsavedPartHashes
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
@@ -551,20 +551,17 @@ void Transport::LoadStaticPassengers()
 {
     if (uint32 mapId = GetGOInfo()->moTransport.SpawnMap)
     {
-        CellObjectGuidsMap const& cells = sObjectMgr->GetMapObjectGuids(mapId, GetMap()->GetSpawnMode());
-        CellGuidSet::const_iterator guidEnd;
-        for (CellObjectGuidsMap::const_iterator cellItr = cells.begin(); cellItr != cells.end(); ++cellItr)
+        // Creatures on transport
+        sObjectMgr->ForEachCreatureOnMap(mapId, GetMap()->GetSpawnMode(), [this](ObjectGuid::LowType guid, CreatureData const* data)
         {
-            // Creatures on transport
-            guidEnd = cellItr->second.creatures.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.creatures.begin(); guidItr != guidEnd; ++guidItr)
-                CreateNPCPassenger(*guidItr, sObjectMgr->GetCreatureData(*guidItr));
-
-            // GameObjects on transport
-            guidEnd = cellItr->second.gameobjects.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.gameobjects.begin(); guidItr != guidEnd; ++guidItr)
-                CreateGOPassenger(*guidItr, sObjectMgr->GetGameObjectData(*guidItr));
-        }
+            CreateNPCPassenger(guid, data);
+        });
+
+        // GameObjects on transport
+        sObjectMgr->ForEachGameObjectOnMap(mapId, GetMap()->GetSpawnMode(), [this](ObjectGuid::LowType guid, GameObjectData const* data)
+        {
+            CreateGOPassenger(guid, data);
+        });
     }
 }
 
@@ -26,6 +26,7 @@
 #include "DatabaseEnv.h"
 #include "DB2Structure.h"
 #include "DB2Stores.h"
+#include "DBUpdater.h"
 #include "DisableMgr.h"
 #include "GameTime.h"
 #include "GameObject.h"
@@ -48,6 +49,7 @@
 #include "PoolMgr.h"
 #include "QuestDef.h"
 #include "QueryPackets.h"
+#include "QuerySnapshot.h"
 #include "Random.h"
 #include "ReputationMgr.h"
 #include "ScriptMgr.h"
@@ -62,6 +64,7 @@
 #include "Vehicle.h"
 #include "World.h"
 #include <G3D/g3dmath.h>
+#include <cstdio>
 
 ScriptMapMap sSpellScripts;
 ScriptMapMap sEventScripts;
@@ -244,7 +247,8 @@ ObjectMgr::ObjectMgr():
     _voidItemId(1),
     _creatureSpawnId(1),
     _gameObjectSpawnId(1),
-    DBCLocaleIndex(LOCALE_enUS)
+    DBCLocaleIndex(LOCALE_enUS),
+    _worldDataSnapshotInvalidated(false)
 {
     for (uint8 i = 0; i < MAX_CLASSES; ++i)
         for (uint8 j = 0; j < MAX_RACES; ++j)
@@ -325,6 +329,72 @@ void ObjectMgr::LoadGraveyardOrientations()
     TC_LOG_INFO("server.loading", ">> Loaded %lu graveyard orientations in %u ms", (unsigned long)_graveyardOrientations.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
+void ObjectMgr::LoadWorldDataSnapshot(std::string const& path)
+{
+    uint32 oldMSTime = getMSTime();
+
+    // the snapshot is only as current as the update history and the writes of this server (InvalidateWorldDataSnapshot),
+    // rows edited by hand are not noticed
+    std::string state = DBUpdater<WorldDatabaseConnection>::GetStateHash(WorldDatabase);
+    if (state.empty())
+    {
+        TC_LOG_ERROR("server.loading", ">> World data snapshot disabled, DB table `updates` is empty.");
+        return;
+    }
+
+    _worldDataSnapshotPath = path;
+    _worldDataSnapshot = std::make_unique<QuerySnapshot>(path, std::move(state));
+    if (_worldDataSnapshot->Load())
+        TC_LOG_INFO("server.loading", ">> Loaded world data snapshot %s in %u ms", path.c_str(), GetMSTimeDiffToNow(oldMSTime));
+    else
+        TC_LOG_INFO("server.loading", ">> World data snapshot %s is missing or outdated, world data is read from the database", path.c_str());
+}
+
+void ObjectMgr::SaveWorldDataSnapshot()
+{
+    if (!_worldDataSnapshot)
+        return;
+
+    uint32 oldMSTime = getMSTime();
+    uint32 replayed = _worldDataSnapshot->GetReplayedCount();
+    uint32 queried = _worldDataSnapshot->GetQueriedCount();
+    if (_worldDataSnapshotInvalidated)
+        TC_LOG_INFO("server.loading", ">> World data snapshot not saved, world data was changed while loading");
+    else if (queried && _worldDataSnapshot->Save())
+        TC_LOG_INFO("server.loading", ">> Saved world data snapshot (%u queries replayed, %u read from the database) in %u ms", replayed, queried, GetMSTimeDiffToNow(oldMSTime));
+    else if (!queried)
+        TC_LOG_INFO("server.loading", ">> World data snapshot is up to date (%u queries replayed)", replayed);
+
+    // reload commands must see the database
+    _worldDataSnapshot.reset();
+}
+
+void ObjectMgr::InvalidateWorldDataSnapshot()
+{
+    if (_worldDataSnapshotPath.empty() || _worldDataSnapshotInvalidated.exchange(true))
+        return;
+
+    // the write is queued already, the next start must read the tables from the database even if this server crashes
+    if (std::remove(_worldDataSnapshotPath.c_str()) == 0)
+        TC_LOG_INFO("misc", "World data changed, deleted world data snapshot %s", _worldDataSnapshotPath.c_str());
+}
+
+QueryResult ObjectMgr::QueryWorldData(char const* sql)
+{
+    if (_worldDataSnapshot)
+        return _worldDataSnapshot->Query(WorldDatabase, sql);
+
+    return WorldDatabase.Query(sql);
+}
+
+QueryResult ObjectMgr::StreamWorldData(char const* sql)
+{
+    if (_worldDataSnapshot)
+        return _worldDataSnapshot->Query(WorldDatabase, sql);
+
+    return WorldDatabase.StreamQuery(sql);
+}
+
 void ObjectMgr::LoadCreatureLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -332,7 +402,7 @@ void ObjectMgr::LoadCreatureLocales()
     _creatureLocaleStore.clear(); // need for reload case
 
     //                                               0      1       2     3           4
-    QueryResult result = WorldDatabase.Query("SELECT entry, locale, Name, FemaleName, Title FROM creature_template_locale");
+    QueryResult result = QueryWorldData("SELECT entry, locale, Name, FemaleName, Title FROM creature_template_locale");
     if (!result)
         return;
 
@@ -364,7 +434,7 @@ void ObjectMgr::LoadGossipMenuItemsLocales()
     _gossipMenuItemsLocaleStore.clear();                              // need for reload case
 
     //                                               0       1            2       3           4
-    QueryResult result = WorldDatabase.Query("SELECT MenuID, OptionID, Locale, OptionText, BoxText FROM gossip_menu_option_locale");
+    QueryResult result = QueryWorldData("SELECT MenuID, OptionID, Locale, OptionText, BoxText FROM gossip_menu_option_locale");
 
     if (!result)
         return;
@@ -396,7 +466,7 @@ void ObjectMgr::LoadPointOfInterestLocales()
     _pointOfInterestLocaleStore.clear();                              // need for reload case
 
     //                                               0   1       2
-    QueryResult result = WorldDatabase.Query("SELECT ID, locale, Name FROM points_of_interest_locale");
+    QueryResult result = QueryWorldData("SELECT ID, locale, Name FROM points_of_interest_locale");
 
     if (!result)
         return;
@@ -424,7 +494,7 @@ void ObjectMgr::LoadCreatureTemplates()
     uint32 oldMSTime = getMSTime();
 
     //                                               0      1                   2                   3                   4            5            6         7         8
-    QueryResult result = WorldDatabase.Query("SELECT entry, difficulty_entry_1, difficulty_entry_2, difficulty_entry_3, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
+    QueryResult result = QueryWorldData("SELECT entry, difficulty_entry_1, difficulty_entry_2, difficulty_entry_3, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
     //                                        9         10    11          12       13        14              15        16        17   18       19       20       21          22
                                              "modelid4, name, femaleName, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, exp_unk, faction, npcflag, speed_walk, speed_run, "
     //                                        23      24     25         26              27               28            29             30          31          32
@@ -2058,7 +2128,7 @@ void ObjectMgr::LoadCreatures()
     uint32 oldMSTime = getMSTime();
 
     //                                               0              1   2    3           4           5           6            7        8             9              10
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
+    QueryResult result = StreamWorldData("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
     //   11               12         13       14            15         16          17           18                19                    20                    21
         "currentwaypoint, curhealth, curmana, MovementType, spawnMask, eventEntry, poolSpawnId, creature.npcflag, creature.unit_flags, creature.dynamicflags, creature.phaseUseFlags, "
     //   22                23                   24                       25
@@ -2252,6 +2322,7 @@ void ObjectMgr::LoadCreatures()
             stmt->setUInt64(2, guid);
 
             WorldDatabase.Execute(stmt);
+            InvalidateWorldDataSnapshot();
         }
 
         // Add to grid if not managed by the game event
@@ -2260,6 +2331,14 @@ void ObjectMgr::LoadCreatures()
     }
     while (result->NextRow());
 
+    if (result->HasError())
+    {
+        TC_LOG_FATAL("sql.sql", "Reading `creature` rows failed after " SZFMTD " creatures, aborting.", _creatureDataStore.size());
+        ABORT();
+    }
+
+    _creatureCellIndex.Build();
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " creatures in %u ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2271,8 +2350,7 @@ void ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType guid, CreatureData const*
         if (mask & 1)
         {
             CellCoord cellCoord = Trinity::ComputeCellCoord(data->spawnPoint.GetPositionX(), data->spawnPoint.GetPositionY());
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapId, i)][cellCoord.GetId()];
-            cell_guids.creatures.insert(guid);
+            _creatureCellIndex.Insert(CreatureCellIndex::MakeKey(MAKE_PAIR32(data->mapId, i), cellCoord.GetId()), guid, data);
         }
     }
 }
@@ -2285,8 +2363,7 @@ void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType guid, CreatureData co
         if (mask & 1)
         {
             CellCoord cellCoord = Trinity::ComputeCellCoord(data->spawnPoint.GetPositionX(), data->spawnPoint.GetPositionY());
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapId, i)][cellCoord.GetId()];
-            cell_guids.creatures.erase(guid);
+            _creatureCellIndex.Remove(CreatureCellIndex::MakeKey(MAKE_PAIR32(data->mapId, i), cellCoord.GetId()), guid);
         }
     }
 }
@@ -2296,7 +2373,7 @@ void ObjectMgr::LoadGameObjects()
     uint32 oldMSTime = getMSTime();
 
     //                                               0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    QueryResult result = StreamWorldData("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14         15          16
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, eventEntry, poolSpawnId, "
     //   17             18       19          20              21
@@ -2503,6 +2580,7 @@ void ObjectMgr::LoadGameObjects()
             stmt->setUInt64(2, guid);
 
             WorldDatabase.Execute(stmt);
+            InvalidateWorldDataSnapshot();
         }
 
         if (gameEvent == 0)                      // if not this is to be managed by GameEvent System or Pool system
@@ -2510,6 +2588,14 @@ void ObjectMgr::LoadGameObjects()
     }
     while (result->NextRow());
 
+    if (result->HasError())
+    {
+        TC_LOG_FATAL("sql.sql", "Reading `gameobject` rows failed after " SZFMTD " gameobjects, aborting.", _gameObjectDataStore.size());
+        ABORT();
+    }
+
+    _gameObjectCellIndex.Build();
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gameobjects in %u ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2739,8 +2825,7 @@ void ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType guid, GameObjectData con
         if (mask & 1)
         {
             CellCoord cellCoord = Trinity::ComputeCellCoord(data->spawnPoint.GetPositionX(), data->spawnPoint.GetPositionY());
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapId, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.insert(guid);
+            _gameObjectCellIndex.Insert(GameObjectCellIndex::MakeKey(MAKE_PAIR32(data->mapId, i), cellCoord.GetId()), guid, data);
         }
     }
 }
@@ -2753,8 +2838,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(ObjectGuid::LowType guid, GameObjectDat
         if (mask & 1)
         {
             CellCoord cellCoord = Trinity::ComputeCellCoord(data->spawnPoint.GetPositionX(), data->spawnPoint.GetPositionY());
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapId, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.erase(guid);
+            _gameObjectCellIndex.Remove(GameObjectCellIndex::MakeKey(MAKE_PAIR32(data->mapId, i), cellCoord.GetId()), guid);
         }
     }
 }
@@ -4003,7 +4087,7 @@ void ObjectMgr::LoadQuests()
 
     _exclusiveQuestGroups.clear();
 
-    QueryResult result = WorldDatabase.Query("SELECT "
+    QueryResult result = QueryWorldData("SELECT "
         //0  1          2           3         4            5            6
         "ID, QuestType, QuestLevel, MinLevel, QuestSortID, QuestInfoID, SuggestedGroupNum, "
         //7                  8                   9                      10
@@ -4088,7 +4172,7 @@ void ObjectMgr::LoadQuests()
 
     for (QuestLoaderHelper const& loader : QuestLoaderHelpers)
     {
-        QueryResult result = WorldDatabase.PQuery("SELECT %s FROM %s", loader.QueryFields, loader.TableName);
+        QueryResult result = QueryWorldData(Trinity::StringFormat("SELECT %s FROM %s", loader.QueryFields, loader.TableName).c_str());
 
         if (!result)
             TC_LOG_ERROR("server.loading", ">> Loaded 0 quest %s. DB table `%s` is empty.", loader.TableDesc, loader.TableName);
@@ -4888,7 +4972,7 @@ void ObjectMgr::LoadQuestLocales()
     _questLocaleStore.clear();                                // need for reload case
 
     //                                               0   1       2      3        4           5                6                 7        8              9                     10                    11                   12                   13              14              15              16
-    QueryResult result = WorldDatabase.Query("SELECT ID, locale, Title, Details, Objectives, OfferRewardText, RequestItemsText, EndText, CompletedText, QuestGiverTextWindow, QuestGiverTargetName, QuestTurnTextWindow, QuestTurnTargetName, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM quest_template_locale");
+    QueryResult result = QueryWorldData("SELECT ID, locale, Title, Details, Objectives, OfferRewardText, RequestItemsText, EndText, CompletedText, QuestGiverTextWindow, QuestGiverTargetName, QuestTurnTextWindow, QuestTurnTargetName, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM quest_template_locale");
     if (!result)
         return;
 
@@ -5539,7 +5623,7 @@ void ObjectMgr::LoadPageTextLocales()
     _pageTextLocaleStore.clear(); // needed for reload case
 
     //                                               0   1        2
-    QueryResult result = WorldDatabase.Query("SELECT ID, locale, `Text` FROM page_text_locale");
+    QueryResult result = QueryWorldData("SELECT ID, locale, `Text` FROM page_text_locale");
 
     if (!result)
         return;
@@ -5726,7 +5810,7 @@ void ObjectMgr::LoadGossipText()
 {
     uint32 oldMSTime = getMSTime();
 
-    QueryResult result = WorldDatabase.Query("SELECT ID, "
+    QueryResult result = QueryWorldData("SELECT ID, "
         "text0_0, text0_1, BroadcastTextID0, lang0, Probability0, EmoteDelay0_0, Emote0_0, EmoteDelay0_1, Emote0_1, EmoteDelay0_2, Emote0_2, "
         "text1_0, text1_1, BroadcastTextID1, lang1, Probability1, EmoteDelay1_0, Emote1_0, EmoteDelay1_1, Emote1_1, EmoteDelay1_2, Emote1_2, "
         "text2_0, text2_1, BroadcastTextID2, lang2, Probability2, EmoteDelay2_0, Emote2_0, EmoteDelay2_1, Emote2_1, EmoteDelay2_2, Emote2_2, "
@@ -5811,7 +5895,7 @@ void ObjectMgr::LoadNpcTextLocales()
 
     _npcTextLocaleStore.clear();                              // need for reload case
 
-    QueryResult result = WorldDatabase.Query("SELECT ID, Locale, "
+    QueryResult result = QueryWorldData("SELECT ID, Locale, "
     //   2        3        4        5        6        7        8        9        10       11       12       13       14       15       16       17
         "Text0_0, Text0_1, Text1_0, Text1_1, Text2_0, Text2_1, Text3_0, Text3_1, Text4_0, Text4_1, Text5_0, Text5_1, Text6_0, Text6_1, Text7_0, Text7_1 "
         "FROM npc_text_locale");
@@ -6113,7 +6197,7 @@ void ObjectMgr::LoadQuestGreetingsLocales()
     _questGreetingLocaleStore.clear();                              // need for reload case
 
     //                                               0     1      2       3
-    QueryResult result = WorldDatabase.Query("SELECT ID, Type, Locale, Greeting FROM quest_greeting_locale");
+    QueryResult result = QueryWorldData("SELECT ID, Type, Locale, Greeting FROM quest_greeting_locale");
     if (!result)
     {
         TC_LOG_INFO("server.loading", ">> Loaded 0 quest_greeting locales. DB table `quest_greeting_locale` is empty.");
@@ -6969,7 +7053,7 @@ void ObjectMgr::LoadGameObjectLocales()
     _gameObjectLocaleStore.clear(); // need for reload case
 
     //                                               0      1       2     3
-    QueryResult result = WorldDatabase.Query("SELECT entry, locale, name, castBarCaption FROM gameobject_template_locale");
+    QueryResult result = QueryWorldData("SELECT entry, locale, name, castBarCaption FROM gameobject_template_locale");
     if (!result)
         return;
 
@@ -7057,7 +7141,7 @@ void ObjectMgr::LoadGameObjectTemplate()
     uint32 oldMSTime = getMSTime();
 
     //                                               0      1     2          3     4         5               6     7
-    QueryResult result = WorldDatabase.Query("SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, size, "
+    QueryResult result = QueryWorldData("SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, size, "
     //                                        8      9      10     11     12     13     14     15     16     17     18      19      20
                                              "Data0, Data1, Data2, Data3, Data4, Data5, Data6, Data7, Data8, Data9, Data10, Data11, Data12, "
     //                                        21      22      23      24      25      26      27      28      29      30      31      32      33      34      35      36
@@ -8820,7 +8904,7 @@ void ObjectMgr::LoadTrainers()
         }
     }
 
-    if (QueryResult trainerLocalesResult = WorldDatabase.Query("SELECT Id, locale, Greeting_lang FROM trainer_locale"))
+    if (QueryResult trainerLocalesResult = QueryWorldData("SELECT Id, locale, Greeting_lang FROM trainer_locale"))
     {
         do
         {
@@ -9342,7 +9426,7 @@ void ObjectMgr::LoadBroadcastTexts()
     _broadcastTextStore.clear(); // for reload case
 
     //                                               0   1            2      3      4         5         6         7            8            9            10              11        12
-    QueryResult result = WorldDatabase.Query("SELECT ID, LanguageID, `Text`, Text1, EmoteID1, EmoteID2, EmoteID3, EmoteDelay1, EmoteDelay2, EmoteDelay3, SoundEntriesID, EmotesID, Flags FROM broadcast_text");
+    QueryResult result = QueryWorldData("SELECT ID, LanguageID, `Text`, Text1, EmoteID1, EmoteID2, EmoteID3, EmoteDelay1, EmoteDelay2, EmoteDelay3, SoundEntriesID, EmotesID, Flags FROM broadcast_text");
     if (!result)
     {
         TC_LOG_INFO("server.loading", ">> Loaded 0 broadcast texts. DB table `broadcast_text` is empty.");
@@ -9425,7 +9509,7 @@ void ObjectMgr::LoadBroadcastTextLocales()
     uint32 oldMSTime = getMSTime();
 
     //                                               0   1        2     3
-    QueryResult result = WorldDatabase.Query("SELECT ID, locale, `Text`, Text1 FROM broadcast_text_locale");
+    QueryResult result = QueryWorldData("SELECT ID, locale, `Text`, Text1 FROM broadcast_text_locale");
     if (!result)
     {
         TC_LOG_INFO("server.loading", ">> Loaded 0 broadcast text locales. DB table `broadcast_text_locale` is empty.");
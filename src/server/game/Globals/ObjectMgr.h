@@ -34,9 +34,11 @@
 #include "Position.h"
 #include "QuestDef.h"
 #include "SharedDefines.h"
+#include "SpawnCellIndex.h"
 #include "Trainer.h"
 #include "VehicleDefines.h"
 #include <iterator>
+#include <limits>
 #include <map>
 #include <unordered_map>
 
@@ -44,6 +46,7 @@ class Item;
 class Unit;
 class Vehicle;
 class Map;
+class QuerySnapshot;
 enum GossipOptionIcon : uint8;
 struct AccessRequirement;
 struct DeclinedName;
@@ -526,15 +529,6 @@ struct BroadcastText
 
 typedef std::unordered_map<uint32, BroadcastText> BroadcastTextContainer;
 
-typedef std::set<ObjectGuid::LowType> CellGuidSet;
-struct CellObjectGuids
-{
-    CellGuidSet creatures;
-    CellGuidSet gameobjects;
-};
-typedef std::unordered_map<uint32/*cell_id*/, CellObjectGuids> CellObjectGuidsMap;
-typedef std::unordered_map<uint32/*(mapid, spawnMode) pair*/, CellObjectGuidsMap> MapObjectGuids;
-
 struct CreatureMovementInfoOverride
 {
     float WalkSpeed;
@@ -558,6 +552,8 @@ typedef std::unordered_map<uint32, GameObjectTemplate> GameObjectTemplateContain
 typedef std::unordered_map<uint32, GameObjectTemplateAddon> GameObjectTemplateAddonContainer;
 typedef std::unordered_map<ObjectGuid::LowType, GameObjectData> GameObjectDataContainer;
 typedef std::unordered_map<ObjectGuid::LowType, GameObjectAddon> GameObjectAddonContainer;
+typedef Trinity::SpawnCellIndex<ObjectGuid::LowType, CreatureData const*> CreatureCellIndex;
+typedef Trinity::SpawnCellIndex<ObjectGuid::LowType, GameObjectData const*> GameObjectCellIndex;
 typedef std::unordered_map<uint32, std::vector<uint32>> GameObjectQuestItemMap;
 typedef std::unordered_map<uint32, SpawnGroupTemplateData> SpawnGroupDataContainer;
 typedef std::multimap<uint32, SpawnMetadata const*> SpawnGroupLinkContainer;
@@ -1177,6 +1173,12 @@ class TC_GAME_API ObjectMgr
         void LoadSpellScriptNames();
         void ValidateSpellScripts();
 
+        /// Until SaveWorldDataSnapshot, world data tables are replayed from the snapshot file when it matches the database
+        void LoadWorldDataSnapshot(std::string const& path);
+        void SaveWorldDataSnapshot();
+        /// Called for writes to world data tables, the snapshot no longer matches them and is deleted
+        void InvalidateWorldDataSnapshot();
+
         void LoadBroadcastTexts();
         void LoadBroadcastTextLocales();
         void LoadCreatureClassLevelStats();
@@ -1323,14 +1325,30 @@ class TC_GAME_API ObjectMgr
             return nullptr;
         }
 
-        CellObjectGuids const& GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
+        // Calls fn(spawnId, data) for every creature spawned in the cell
+        template<typename Fn>
+        void ForEachCreatureInCell(uint16 mapid, uint8 spawnMode, uint32 cell_id, Fn&& fn) const
         {
-            return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)][cell_id];
+            _creatureCellIndex.ForEach(CreatureCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), cell_id), std::forward<Fn>(fn));
         }
 
-        CellObjectGuidsMap const& GetMapObjectGuids(uint16 mapid, uint8 spawnMode)
+        template<typename Fn>
+        void ForEachGameObjectInCell(uint16 mapid, uint8 spawnMode, uint32 cell_id, Fn&& fn) const
         {
-            return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)];
+            _gameObjectCellIndex.ForEach(GameObjectCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), cell_id), std::forward<Fn>(fn));
+        }
+
+        // Calls fn(spawnId, data) for every creature spawned on the map
+        template<typename Fn>
+        void ForEachCreatureOnMap(uint16 mapid, uint8 spawnMode, Fn&& fn) const
+        {
+            _creatureCellIndex.ForEachInRange(CreatureCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), 0), CreatureCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), std::numeric_limits<uint32>::max()), std::forward<Fn>(fn));
+        }
+
+        template<typename Fn>
+        void ForEachGameObjectOnMap(uint16 mapid, uint8 spawnMode, Fn&& fn) const
+        {
+            _gameObjectCellIndex.ForEachInRange(GameObjectCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), 0), GameObjectCellIndex::MakeKey(MAKE_PAIR32(mapid, spawnMode), std::numeric_limits<uint32>::max()), std::forward<Fn>(fn));
         }
 
         /**
@@ -1706,12 +1724,19 @@ class TC_GAME_API ObjectMgr
 
 
     private:
+        QueryResult QueryWorldData(char const* sql);
+        // For large tables whose load loop does not run synchronous world database queries
+        QueryResult StreamWorldData(char const* sql);
         void LoadScripts(ScriptsType type);
         void LoadQuestRelationsHelper(QuestRelations& map, QuestRelationsReverse* reverseMap, std::string const& table);
         QuestRelationResult GetQuestRelationsFrom(QuestRelations const& map, uint32 key, bool onlyActive) const { return { map.equal_range(key), onlyActive }; }
         QuestRelationResult GetQuestRelationsReverseFrom(QuestRelationsReverse const& map, uint32 key, bool onlyActive) const { return { map.equal_range(key), onlyActive }; }
         void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
 
+        std::unique_ptr<QuerySnapshot> _worldDataSnapshot;
+        std::string _worldDataSnapshotPath;
+        std::atomic<bool> _worldDataSnapshotInvalidated;
+
         MailLevelRewardContainer _mailLevelRewardStore;
 
         CreatureBaseStatsContainer _creatureBaseStatsStore;
@@ -1737,7 +1762,8 @@ class TC_GAME_API ObjectMgr
         HalfNameContainer _petHalfName0;
         HalfNameContainer _petHalfName1;
 
-        MapObjectGuids _mapObjectGuidsStore;
+        CreatureCellIndex _creatureCellIndex;
+        GameObjectCellIndex _gameObjectCellIndex;
         CreatureDataContainer _creatureDataStore;
         CreatureTemplateContainer _creatureTemplateStore;
         CreatureModelContainer _creatureModelStore;
@@ -23,9 +23,68 @@
 #include "Transport.h"
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
+#include "PositionBatch.h"
+#include <deque>
 
 using namespace Trinity;
 
+namespace
+{
+    struct RelocationScratch
+    {
+        PositionBatch<Creature*> Creatures;
+        std::vector<uint8> InRange;
+    };
+
+    // Notifiers can nest (AI reacting to a unit may update the visibility of another one),
+    // every nesting level on a thread gets its own buffers
+    class RelocationScratchLease
+    {
+    public:
+        RelocationScratchLease() : _scratch(Acquire()) { }
+        ~RelocationScratchLease() { --_depth; }
+
+        RelocationScratchLease(RelocationScratchLease const&) = delete;
+        RelocationScratchLease& operator=(RelocationScratchLease const&) = delete;
+
+        RelocationScratch* operator->() const { return &_scratch; }
+
+    private:
+        static RelocationScratch& Acquire()
+        {
+            if (_pool.size() <= _depth)
+                _pool.emplace_back();
+
+            return _pool[_depth++];
+        }
+
+        RelocationScratch& _scratch;
+
+        static thread_local std::deque<RelocationScratch> _pool;
+        static thread_local std::size_t _depth;
+    };
+
+    thread_local std::deque<RelocationScratch> RelocationScratchLease::_pool;
+    thread_local std::size_t RelocationScratchLease::_depth = 0;
+
+    void GatherCreatures(CreatureMapType& m, PositionBatch<Creature*>& batch)
+    {
+        batch.Clear();
+        for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        {
+            Creature* c = iter->GetSource();
+            batch.Add(c, c->GetPositionX(), c->GetPositionY(), c->GetCombatReach(), c->GetSightRange());
+        }
+    }
+
+    // Out of sight range a creature can only notice a unit through the checks of CanSeeOrDetect that come
+    // before the distance check - Unit::IsAlwaysVisibleFor (owner) and Creature::CanAlwaysSee (AI)
+    inline bool CanSeeBeyondSightRange(Creature const* c, Unit const* u)
+    {
+        return u->GetCharmerOrOwnerGUID() == c->GetGUID() || (c->IsAIEnabled() && c->AI()->CanSeeAlways(u));
+    }
+}
+
 void VisibleNotifier::SendToSelf()
 {
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
@@ -195,12 +254,20 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     if (!i_creature.IsAlive())
         return;
 
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    // range check the whole cell at once, pairs out of sight range in both directions skip CanSeeOrDetect
+    RelocationScratchLease scratch;
+    GatherCreatures(m, scratch->Creatures);
+    scratch->Creatures.FilterWithinMutualRange2d(i_creature.GetPositionX(), i_creature.GetPositionY(), i_creature.GetCombatReach(), i_creature.GetSightRange(), scratch->InRange);
+
+    for (std::size_t i = 0; i < scratch->Creatures.Size(); ++i)
     {
-        Creature* c = iter->GetSource();
-        CreatureUnitRelocationWorker(&i_creature, c);
+        Creature* c = scratch->Creatures[i];
+        bool const inRange = scratch->InRange[i] != 0;
 
-        if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+        if (inRange || CanSeeBeyondSightRange(&i_creature, c))
+            CreatureUnitRelocationWorker(&i_creature, c);
+
+        if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED) && (inRange || CanSeeBeyondSightRange(c, &i_creature)))
             CreatureUnitRelocationWorker(c, &i_creature);
     }
 }
@@ -244,11 +311,18 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
 
 void AIRelocationNotifier::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    RelocationScratchLease scratch;
+    GatherCreatures(m, scratch->Creatures);
+    scratch->Creatures.FilterWithinMutualRange2d(i_unit.GetPositionX(), i_unit.GetPositionY(), i_unit.GetCombatReach(), isCreature ? i_unit.GetSightRange() : 0.0f, scratch->InRange);
+
+    for (std::size_t i = 0; i < scratch->Creatures.Size(); ++i)
     {
-        Creature* c = iter->GetSource();
-        CreatureUnitRelocationWorker(c, &i_unit);
-        if (isCreature)
+        Creature* c = scratch->Creatures[i];
+        bool const inRange = scratch->InRange[i] != 0;
+
+        if (inRange || CanSeeBeyondSightRange(c, &i_unit))
+            CreatureUnitRelocationWorker(c, &i_unit);
+        if (isCreature && (inRange || CanSeeBeyondSightRange((Creature*)&i_unit, c)))
             CreatureUnitRelocationWorker((Creature*)&i_unit, c);
     }
 }
@@ -30,6 +30,8 @@
 #include "TemporarySummon.h"
 #include "UnitAI.h"
 #include "UpdateData.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
 
 namespace Trinity
 {
@@ -120,6 +122,7 @@ namespace Trinity
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<SharedWorldPacket const> i_sharedMessage;  // copied once on first receiver, queued to all of them
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
@@ -147,7 +150,10 @@ namespace Trinity
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<SharedWorldPacket const>(*i_message);
+
+            player->GetSession()->SendPacket(i_sharedMessage);
         }
     };
 
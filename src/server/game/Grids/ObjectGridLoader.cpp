@@ -99,38 +99,38 @@ void AddObjectHelper(CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map*
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
+void LoadHelper(ObjectGuid::LowType guid, SpawnData const* data, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
 {
-    for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
+    // Don't spawn at all if there's a respawn timer
+    if (!map->ShouldBeSpawnedOnGridLoad(data))
+        return;
+
+    T* obj = new T;
+    //TC_LOG_INFO("misc", "DEBUG: LoadHelper from table: %s for (guid: %u) Loading", table, guid);
+    if (!obj->LoadFromDB(guid, map, false, false))
     {
-        // Don't spawn at all if there's a respawn timer
-        ObjectGuid::LowType guid = *i_guid;
-        if (!map->ShouldBeSpawnedOnGridLoad<T>(guid))
-            continue;
-
-        T* obj = new T;
-        //TC_LOG_INFO("misc", "DEBUG: LoadHelper from table: %s for (guid: %u) Loading", table, guid);
-        if (!obj->LoadFromDB(guid, map, false, false))
-        {
-            delete obj;
-            continue;
-        }
-        AddObjectHelper(cell, m, count, map, obj);
+        delete obj;
+        return;
     }
+    AddObjectHelper(cell, m, count, map, obj);
 }
 
 void ObjectGridLoader::Visit(GameObjectMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
+    sObjectMgr->ForEachGameObjectInCell(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId(), [&](ObjectGuid::LowType guid, GameObjectData const* data)
+    {
+        LoadHelper(guid, data, cellCoord, m, i_gameObjects, i_map);
+    });
 }
 
 void ObjectGridLoader::Visit(CreatureMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.creatures, cellCoord, m, i_creatures, i_map);
+    sObjectMgr->ForEachCreatureInCell(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId(), [&](ObjectGuid::LowType guid, CreatureData const* data)
+    {
+        LoadHelper(guid, data, cellCoord, m, i_creatures, i_map);
+    });
 }
 
 void ObjectWorldLoader::Visit(CorpseMapType& /*m*/)
@@ -882,7 +882,7 @@ void Guild::Member::ResetWeekActivityAndReputation()
     stmt2->setUInt32(0, m_guid.GetCounter());
     trans->Append(stmt2);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_guildId));
 }
 
 void Guild::Member::UpdateProfessionData()
@@ -1382,7 +1382,7 @@ bool Guild::Create(Player* pLeader, std::string const& name)
     _CreateDefaultGuildRanks(trans, pLeaderSession->GetSessionDbLocaleIndex()); // Create default ranks
     bool ret = AddMember(trans, m_leaderGuid, GR_GUILDMASTER);                  // Add guildmaster
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     if (ret)
     {
@@ -1440,7 +1440,7 @@ void Guild::Disband()
     stmt->setUInt32(0, m_id);
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     sGuildFinderMgr->DeleteGuild(m_id);
 
@@ -1460,7 +1460,7 @@ void Guild::SaveToDB()
 
     m_achievementMgr->SaveToDB(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 }
 
 void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
@@ -1763,7 +1763,7 @@ void Guild::HandleSetNewGuildMaster(WorldSession* session, std::string const& na
     _SetLeader(trans, newGuildMaster);
     oldGuildMaster->ChangeRank(trans, GR_INITIATE);
     _BroadcastEvent(GE_LEADER_CHANGED, ObjectGuid::Empty, player->GetName().c_str(), newGuildMaster->GetName().c_str());
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 }
 
 void Guild::HandleSetBankTabInfo(WorldSession* session, uint8 tabId, std::string const& name, std::string const& icon)
@@ -2192,7 +2192,7 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint64 amount, bool
     }
 
     _LogBankEvent(trans, cashFlow ? GUILD_BANK_LOG_CASH_FLOW_DEPOSIT : GUILD_BANK_LOG_DEPOSIT_MONEY, uint8(0), player->GetGUID().GetCounter(), amount);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     std::string aux = ByteArrayToHexStr(reinterpret_cast<uint8*>(&m_bankMoney), 8, true);
     _BroadcastEvent(GE_BANK_MONEY_SET, player->GetGUID(), aux.c_str());
@@ -2245,7 +2245,7 @@ bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint64 amount, bool
 
     // Log guild bank event
     _LogBankEvent(trans, repair ? GUILD_BANK_LOG_REPAIR_MONEY : GUILD_BANK_LOG_WITHDRAW_MONEY, uint8(0), player->GetGUID().GetCounter(), amount);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     std::string aux = ByteArrayToHexStr(reinterpret_cast<uint8*>(&m_bankMoney), 8, true);
     _BroadcastEvent(GE_BANK_MONEY_SET, player->GetGUID(), aux.c_str());
@@ -2755,7 +2755,7 @@ bool Guild::Validate()
                 itr->second->ChangeRank(trans, GR_OFFICER);
 
     if (trans->GetSize() > 0)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
     _UpdateAccountsNumber();
     return true;
 }
@@ -3156,7 +3156,7 @@ void Guild::_CreateNewBankTab()
     for (auto itr = m_ranks.begin(); itr != m_ranks.end(); ++itr)
         (*itr).CreateMissingTabsIfNeeded(tabId, trans, false);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 }
 
 void Guild::_CreateDefaultGuildRanks(CharacterDatabaseTransaction& trans, LocaleConstant loc)
@@ -3196,7 +3196,7 @@ bool Guild::_CreateRank(CharacterDatabaseTransaction& trans, std::string const&
     info.SaveToDB(trans);
 
     if (!isInTransaction)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     return true;
 }
@@ -3278,7 +3278,7 @@ void Guild::_SetLeader(CharacterDatabaseTransaction& trans, Member* pLeader)
     trans->Append(stmt);
 
     if (!isInTransaction)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 }
 
 void Guild::_SetRankBankMoneyPerDay(uint8 rankId, uint32 moneyPerDay)
@@ -3390,7 +3390,7 @@ inline void Guild::_LogEvent(GuildEventLogTypes eventType, ObjectGuid::LowType p
 {
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     m_eventLog->AddEvent(trans, new EventLogEntry(m_id, m_eventLog->GetNextGUID(), eventType, playerGuid1, playerGuid2, newRank));
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     sScriptMgr->OnGuildEvent(this, uint8(eventType), playerGuid1, playerGuid2, newRank);
 }
@@ -3531,7 +3531,7 @@ bool Guild::_DoItemsMove(MoveItemData* pSrc, MoveItemData* pDest, bool sendError
     if (swap)
         pSrc->StoreItem(trans, pDestItem);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
     return true;
 }
 
@@ -3820,7 +3820,7 @@ void Guild::CompleteChallenge(uint8 challengeType, Player* source)
     stmt->setUInt32(2, _currChallengeCount[GUILD_CHALLENGE_TYPE_RATED_BG]);
     stmt->setUInt32(3, m_id);
     trans->Append(stmt);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 }
 
 void Guild::GiveReputation(uint32 rep, Player* source)
@@ -3968,7 +3968,7 @@ void Guild::AddGuildNews(uint8 type, ObjectGuid guid, uint32 flags, uint32 value
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     m_newsLog->AddEvent(trans, news);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Guild(m_id));
 
     WorldPackets::Guild::GuildNews newsPacket;
     newsPacket.NewsEvents.reserve(1);
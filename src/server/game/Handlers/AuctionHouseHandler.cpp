@@ -357,7 +357,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket& recvData)
 
         AH->SaveToDB(trans);
         _player->SaveInventoryAndGoldToDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
         SendAuctionCommandResult(AH, AUCTION_SELL_ITEM, ERR_AUCTION_OK);
 
@@ -418,7 +418,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket& recvData)
                 CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
                 item2->DeleteFromInventoryDB(trans);
                 item2->DeleteFromDB(trans);
-                CharacterDatabase.CommitTransaction(trans);
+                CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
                 delete item2;
             }
             else // Item stack count is bigger than required count, update item stack count and save to database - cloned item will be used for auction
@@ -430,7 +430,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket& recvData)
 
                 CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
                 item2->SaveToDB(trans);
-                CharacterDatabase.CommitTransaction(trans);
+                CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
             }
         }
 
@@ -438,7 +438,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket& recvData)
         newItem->SaveToDB(trans);
         AH->SaveToDB(trans);
         _player->SaveInventoryAndGoldToDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
         SendAuctionCommandResult(AH, AUCTION_SELL_ITEM, ERR_AUCTION_OK);
 
@@ -582,7 +582,7 @@ void WorldSession::HandleAuctionPlaceBid(WorldPacket& recvData)
         auctionHouse->RemoveAuction(auction);
     }
     player->SaveInventoryAndGoldToDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 }
 
 //this void is called when auction_owner cancels his auction
@@ -653,7 +653,7 @@ void WorldSession::HandleAuctionRemoveItem(WorldPacket& recvData)
 
     player->SaveInventoryAndGoldToDB(trans);
     auction->DeleteFromDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
     sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
     auctionHouse->RemoveAuction(auction);
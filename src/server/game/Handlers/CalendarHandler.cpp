@@ -305,7 +305,7 @@ void WorldSession::HandleCalendarAddEvent(WorldPacket& recvData)
         }
 
         if (inviteCount > 1)
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
     }
 
     sCalendarMgr->AddEvent(calendarEvent, CALENDAR_SENDTYPE_ADD);
@@ -413,7 +413,7 @@ void WorldSession::HandleCalendarCopyEvent(WorldPacket& recvData)
             sCalendarMgr->AddInvite(newEvent, new CalendarInvite(**itr, sCalendarMgr->GetFreeInviteId(), newEvent->GetEventId()), trans);
 
         if (invites.size() > 1)
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
         // should we change owner when somebody makes a copy of event owned by another person?
     }
     else
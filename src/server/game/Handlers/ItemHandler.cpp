@@ -1030,7 +1030,7 @@ void WorldSession::HandleWrapItemOpcode(WorldPacket& recvData)
         RemoveItemFromUpdateQueueOf(item, _player);
         item->SaveToDB(trans);                                   // item gave inventory record unchanged and can be save standalone
     }
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
     uint32 count = 1;
     _player->DestroyItemCount(gift, count, true);
@@ -394,7 +394,7 @@ void WorldSession::HandleSendMail(WorldPacket& recvData)
         .SendMailTo(trans, MailReceiver(receiver, receiverGuid.GetCounter()), MailSender(player), body.empty() ? MAIL_CHECK_MASK_COPIED : MAIL_CHECK_MASK_HAS_BODY, deliver_delay);
 
     player->SaveInventoryAndGoldToDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 }
 
 //called when mail is read
@@ -499,7 +499,7 @@ void WorldSession::HandleMailReturnToSender(WorldPacket& recvData)
         draft.AddMoney(m->money).SendReturnToSender(GetAccountId(), m->receiver, m->sender, trans);
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
     delete m;                                               //we can deallocate old mail
     player->SendMailResult(mailId, MAIL_RETURNED_TO_SENDER, MAIL_OK);
@@ -601,7 +601,7 @@ void WorldSession::HandleMailTakeItem(WorldPacket& recvData)
 
         player->SaveInventoryAndGoldToDB(trans);
         player->_SaveMail(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
         player->SendMailResult(mailId, MAIL_ITEM_TAKEN, MAIL_OK, 0, itemId, count);
     }
@@ -648,7 +648,7 @@ void WorldSession::HandleMailTakeMoney(WorldPacket& recvData)
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     player->SaveGoldToDB(trans);
     player->_SaveMail(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 }
 
 //called when player lists his received mails
@@ -684,7 +684,7 @@ void WorldSession::HandlePetRename(WorldPacket& recvData)
     stmt->setUInt32(2, pet->GetCharmInfo()->GetPetNumber());
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
     pet->SetUInt32Value(UNIT_FIELD_PET_NAME_TIMESTAMP, uint32(GameTime::GetGameTime())); // cast can't be helped
 }
@@ -938,7 +938,7 @@ void WorldSession::UpdatePetSlot(uint32 petNumberA, uint8 oldPetSlot, uint8 newP
 
     playerPetDataA->Slot = newPetSlot;
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 
     SendPetSlotUpdated(petNumberA, newPetSlot, petNumberB, oldPetSlot);
     SendStableResult(STABLE_SUCCESS_STABLE);
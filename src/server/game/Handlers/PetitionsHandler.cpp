@@ -698,7 +698,7 @@ void WorldSession::HandleTurnInPetitionOpcode(WorldPacket& recvData)
             for (Signature const& signature : signatures)
                 guild->AddMember(trans, signature.second);
 
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
         }
     }
     else
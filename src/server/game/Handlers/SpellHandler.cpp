@@ -221,7 +221,7 @@ void WorldSession::HandleOpenWrappedItemCallback(uint16 pos, ObjectGuid itemGuid
     stmt->setUInt32(0, itemGuid.GetCounter());
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 }
 
 void WorldSession::HandleGameObjectUseOpcode(WorldPacket& recvData)
@@ -229,7 +229,7 @@ void WorldSession::HandleGMSurveySubmit(WorldPacket& recvData)
 
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQLOrderingKey::Account(GetAccountId()));
 }
 
 void WorldSession::HandleReportLag(WorldPacket& recvData)
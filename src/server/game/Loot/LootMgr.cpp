@@ -134,7 +134,7 @@ uint32 LootStore::LoadLootTable()
     Clear();
 
     //                                                0      1     2          3       4              5           6         7        8         9
-    QueryResult result = WorldDatabase.PQuery("SELECT Entry, Item, Reference, Chance, QuestRequired, IsCurrency, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName());
+    QueryResult result = WorldDatabase.StreamQuery(Trinity::StringFormat("SELECT Entry, Item, Reference, Chance, QuestRequired, IsCurrency, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName()).c_str());
     if (!result)
         return 0;
 
@@ -190,6 +190,12 @@ uint32 LootStore::LoadLootTable()
     }
     while (result->NextRow());
 
+    if (result->HasError())
+    {
+        TC_LOG_FATAL("sql.sql", "Reading `%s` rows failed after %u loot entries, aborting.", GetName(), count);
+        ABORT();
+    }
+
     Verify();                                           // Checks validity of the loot store
 
     return count;
@@ -19,8 +19,10 @@
 #include "DBCStores.h"
 #include "GridDefines.h"
 #include "Log.h"
+#include "MappedFile.h"
 #include <G3D/Plane.h>
 #include <G3D/Ray.h>
+#include <cstring>
 
 static uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
@@ -53,6 +55,8 @@ GridMap::GridMap()
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
     _holes = nullptr;
+    _fileData = nullptr;
+    _fileSize = 0;
 }
 
 GridMap::~GridMap()
@@ -60,73 +64,102 @@ GridMap::~GridMap()
     unloadData();
 }
 
-GridMap::LoadResult GridMap::loadData(const char* filename)
+GridMap::LoadResult GridMap::loadData(const char* filename, bool memoryMapped)
 {
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
-        return LoadResult::FileDoesNotExist;
+    // Arrays point straight into the file image, mapped files share their pages with every other map using the tile
+    if (memoryMapped)
+    {
+        std::unique_ptr<Trinity::MappedFile> mappedFile = std::make_unique<Trinity::MappedFile>();
+        if (mappedFile->Open(filename))
+        {
+            _fileData = mappedFile->GetData();
+            _fileSize = mappedFile->GetSize();
+            _mappedFile = std::move(mappedFile);
+        }
+    }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!_fileData)
     {
+        // Not return error if file not found
+        FILE* in = fopen(filename, "rb");
+        if (!in)
+            return LoadResult::FileDoesNotExist;
+
+        long size = -1;
+        if (fseek(in, 0, SEEK_END) == 0)
+            size = ftell(in);
+
+        if (size <= 0 || fseek(in, 0, SEEK_SET) != 0)
+        {
+            fclose(in);
+            return LoadResult::InvalidFile;
+        }
+
+        _fileBuffer = std::make_unique<uint8[]>(size);
+        if (fread(_fileBuffer.get(), size, 1, in) != 1)
+        {
+            fclose(in);
+            unloadData();
+            return LoadResult::InvalidFile;
+        }
+
         fclose(in);
+        _fileData = _fileBuffer.get();
+        _fileSize = std::size_t(size);
+    }
+
+    map_fileheader header;
+    if (!readHeader(header, 0))
+    {
+        unloadData();
         return LoadResult::InvalidFile;
     }
 
     if (header.mapMagic == MapMagic && header.versionMagic == MapVersionMagic)
     {
         // load up area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // loadup holes data (if any. check header.holesOffset)
-        if (header.holesSize && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesSize && !loadHolesData(header.holesOffset, header.holesSize))
         {
             TC_LOG_ERROR("maps", "Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
-        fclose(in);
         return LoadResult::Ok;
     }
 
     TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible map version (%.*s v%u), %.*s v%u is expected. Please pull your source, recompile tools and recreate maps using the updated mapextractor, then replace your old map files with new files. If you still have problems search on forum for error TCE00018.",
         filename, 4, header.mapMagic.data(), header.versionMagic, 4, MapMagic.data(), MapVersionMagic);
-    fclose(in);
+    unloadData();
     return LoadResult::InvalidFile;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -136,64 +169,92 @@ void GridMap::unloadData()
     _liquidMap  = nullptr;
     _holes = nullptr;
     _gridGetHeight = &GridMap::getHeightFromFlat;
+
+    _alignedCopies.clear();
+    _mappedFile.reset();
+    _fileBuffer.reset();
+    _fileData = nullptr;
+    _fileSize = 0;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template <typename T>
+bool GridMap::readHeader(T& header, uint32 offset) const
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (offset > _fileSize || sizeof(T) > _fileSize - offset)
+        return false;
+
+    memcpy(&header, _fileData + offset, sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool GridMap::mapArray(T*& array, uint32 offset, uint32 count)
+{
+    std::size_t const size = std::size_t(count) * sizeof(T);
+    if (offset > _fileSize || size > _fileSize - offset)
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.areaMagic != MapAreaMagic)
+    uint8* data = _fileData + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T))
+    {
+        // arrays placed after an odd sized one (8 bit heights) are not aligned in the file
+        _alignedCopies.push_back(std::make_unique<uint8[]>(size));
+        memcpy(_alignedCopies.back().get(), data, size);
+        data = _alignedCopies.back().get();
+    }
+
+    array = reinterpret_cast<T*>(data);
+    return true;
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
+{
+    map_areaHeader header;
+    if (!readHeader(header, offset) || header.areaMagic != MapAreaMagic)
         return false;
 
     _gridArea = header.gridArea;
     if (!header.flags.HasFlag(map_areaHeaderFlags::NoArea))
-    {
-        _areaMap = new uint16[16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!mapArray(_areaMap, offset + sizeof(header), 16 * 16))
             return false;
-    }
+
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.heightMagic != MapHeightMagic)
+    if (!readHeader(header, offset) || header.heightMagic != MapHeightMagic)
         return false;
 
+    offset += sizeof(header);
     _gridHeight = header.gridHeight;
     if (!header.flags.HasFlag(map_heightHeaderFlags::NoHeight))
     {
         if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!mapArray(m_uint16_V9, offset, 129*129) ||
+                !mapArray(m_uint16_V8, offset + 129*129 * sizeof(uint16), 128*128))
                 return false;
+            offset += (129*129 + 128*128) * sizeof(uint16);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!mapArray(m_uint8_V9, offset, 129*129) ||
+                !mapArray(m_uint8_V8, offset + 129*129 * sizeof(uint8), 128*128))
                 return false;
+            offset += (129*129 + 128*128) * sizeof(uint8);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!mapArray(m_V9, offset, 129*129) ||
+                !mapArray(m_V8, offset + 129*129 * sizeof(float), 128*128))
                 return false;
+            offset += (129*129 + 128*128) * sizeof(float);
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
@@ -204,10 +265,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (fread(maxHeights.data(), sizeof(int16), maxHeights.size(), in) != maxHeights.size() ||
-            fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
+        if (!readHeader(maxHeights, offset) || !readHeader(minHeights, offset + sizeof(maxHeights)))
             return false;
-
         static uint32 constexpr indices[8][3] =
         {
             { 3, 0, 4 },
@@ -245,14 +304,13 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.liquidMagic != MapLiquidMagic)
+    if (!readHeader(header, offset) || header.liquidMagic != MapLiquidMagic)
         return false;
 
+    offset += sizeof(header);
     _liquidGlobalEntry = header.liquidType;
     _liquidGlobalFlags = header.liquidFlags;
     _liquidOffX  = header.offsetX;
@@ -263,33 +321,22 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoType))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
-            return false;
-
-        _liquidFlags = new map_liquidHeaderTypeFlags[16*16];
-        if (fread(_liquidFlags, sizeof(map_liquidHeaderTypeFlags), 16*16, in) != 16*16)
+        if (!mapArray(_liquidEntry, offset, 16*16) ||
+            !mapArray(_liquidFlags, offset + 16*16 * sizeof(uint16), 16*16))
             return false;
+        offset += 16*16 * (sizeof(uint16) + sizeof(map_liquidHeaderTypeFlags));
     }
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoHeight))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        if (!mapArray(_liquidMap, offset, uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    _holes = new uint16[16 * 16];
-    if (fread(_holes, sizeof(uint16), 16 * 16, in) != 16 * 16)
-        return false;
-
-    return true;
+    return mapArray(_holes, offset, 16 * 16);
 }
 
 uint16 GridMap::getArea(float x, float y) const
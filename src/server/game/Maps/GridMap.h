@@ -21,11 +21,13 @@
 #include "Define.h"
 #include "MapDefines.h"
 #include "Optional.h"
-#include <cstdio>
+#include <memory>
+#include <vector>
 
 struct LiquidData;
 enum ZLiquidStatus : uint32;
 namespace G3D { class Plane; }
+namespace Trinity { class MappedFile; }
 
 class TC_GAME_API GridMap
 {
@@ -63,10 +65,22 @@ class TC_GAME_API GridMap
 
     uint16* _holes;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    // Whole file image, all arrays above point into it unless they had to be copied for alignment
+    std::unique_ptr<Trinity::MappedFile> _mappedFile;
+    std::unique_ptr<uint8[]> _fileBuffer;
+    std::vector<std::unique_ptr<uint8[]>> _alignedCopies;
+    uint8* _fileData;
+    std::size_t _fileSize;
+
+    template <typename T>
+    bool readHeader(T& header, uint32 offset) const;
+    template <typename T>
+    bool mapArray(T*& array, uint32 offset, uint32 count);
+
+    bool loadAreaData(uint32 offset, uint32 size);
+    bool loadHeightData(uint32 offset, uint32 size);
+    bool loadLiquidData(uint32 offset, uint32 size);
+    bool loadHolesData(uint32 offset, uint32 size);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -88,7 +102,7 @@ public:
         InvalidFile
     };
 
-    LoadResult loadData(const char* filename);
+    LoadResult loadData(const char* filename, bool memoryMapped = true);
     void unloadData();
 
     uint16 getArea(float x, float y) const;
@@ -41,11 +41,13 @@
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
+#include "PathRequestService.h"
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "PhasingHandler.h"
 #include "ScriptMgr.h"
 #include "TerrainMgr.h"
+#include "ThreadPool.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -55,6 +57,10 @@
 #include "World.h"
 #include "WorldStateMgr.h"
 #include "WorldStatePackets.h"
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <numeric>
 #include <unordered_set>
 #include <vector>
 
@@ -67,6 +73,10 @@ BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(RespawnListContainer::value_type)
 
 GridState* si_GridStates[MAX_GRID_STATE];
 
+// cells (sorted ids) of the update island processed by the current thread
+thread_local Map const* UpdateIslandMap = nullptr;
+thread_local std::vector<uint32> const* UpdateIslandCells = nullptr;
+
 ZoneDynamicInfo::ZoneDynamicInfo() : MusicId(0), DefaultWeather(nullptr), WeatherId(WEATHER_STATE_FINE),
 Intensity(0.0f) { }
 
@@ -94,8 +104,6 @@ Map::~Map()
 
     sOutdoorPvPMgr->DestroyOutdoorPvPForMap(this);
     sBattlefieldMgr->DestroyBattlefieldsForMap(this);
-
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 void Map::LoadAllCells()
@@ -124,11 +132,11 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode) :
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+m_unloadTimer(0), m_lastUpdateDuration(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry), m_terrain(sTerrainMgr.LoadTerrain(id)),
-i_scriptLock(false), _respawnCheckTimer(0)
+_updateIslandsInProgress(false), i_scriptLock(false), _respawnCheckTimer(0)
 {
     for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
     {
@@ -150,7 +158,7 @@ i_scriptLock(false), _respawnCheckTimer(0)
 
     sTransportMgr->CreateTransportsForMap(this);
 
-    MMAP::MMapFactory::createOrGetMMapManager()->loadMapInstance(sWorld->GetDataPath(), GetId(), i_InstanceId);
+    MMAP::MMapFactory::createOrGetMMapManager()->loadMapInstance(sWorld->GetDataPath(), GetId());
 
     _worldStateValues = sWorldStateMgr->GetInitialWorldStatesForMap(this);
 
@@ -340,6 +348,8 @@ void Map::DeleteFromWorld(Player* player)
 //But object data is not loaded here
 void Map::EnsureGridCreated(GridCoord const& p)
 {
+    // a grid is only visible to other islands once it is linked and its terrain is loaded
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         TC_LOG_DEBUG("maps", "Creating grid[%u, %u] for map %u instance %u", p.x_coord, p.y_coord, GetId(), i_InstanceId);
@@ -379,6 +389,8 @@ void Map::EnsureGridLoadedForActiveObject(const Cell &cell, WorldObject* object)
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell &cell)
 {
+    // the loaded flag is set before the grid objects are, so it is only read under the lock
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -427,6 +439,37 @@ void Map::LoadGrid(float x, float y)
     EnsureGridLoaded(Cell(x, y));
 }
 
+void Map::PreloadGridsAhead(float x, float y, float dx, float dy)
+{
+    // terrain of instances is shared by all of them, there is no single thread that could publish preloaded grids
+    if (!sTerrainMgr.IsPreloadingEnabled() || Instanceable())
+        return;
+
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 0.1f)
+        return;
+
+    dx /= length;
+    dy /= length;
+
+    // sample the movement vector every half grid so that every grid it crosses is found
+    float const maxDistance = float(sWorld->getIntConfig(CONFIG_TERRAIN_PRELOAD_DISTANCE));
+    for (float distance = SIZE_OF_GRIDS / 2; distance <= maxDistance; distance += SIZE_OF_GRIDS / 2)
+    {
+        GridCoord p = Trinity::ComputeGridCoord(x + dx * distance, y + dy * distance);
+        if (!p.IsCoordValid())
+            break;
+
+        // grids that exist already have their terrain loaded
+        if (getNGrid(p.x_coord, p.y_coord))
+            continue;
+
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+        sTerrainMgr.QueuePreload(m_terrain, gx, gy, distance);
+    }
+}
+
 bool Map::AddPlayerToMap(Player* player)
 {
     CellCoord cellCoord = Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
@@ -477,6 +520,20 @@ void Map::InitializeObject(GameObject* obj)
 template<class T>
 bool Map::AddToMap(T* obj)
 {
+    // spawns and summons into cells of another update island (or of no island at all) would race with the thread
+    // updating those cells, they fail the same way as spawns at invalid positions
+    if (_updateIslandsInProgress && !obj->IsInWorld())
+    {
+        CellCoord cellCoord = Trinity::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY());
+        if (cellCoord.IsCoordValid() && !IsInCurrentUpdateIsland(cellCoord))
+        {
+            TC_LOG_DEBUG("maps", "Map::Add: Object %s at X:%f Y:%f is outside of the update island adding it", obj->GetGUID().ToString().c_str(), obj->GetPositionX(), obj->GetPositionY());
+            return false;
+        }
+    }
+
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     /// @todo Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -593,6 +650,204 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+std::unique_lock<std::recursive_mutex> Map::AcquireIslandUpdateLock() const
+{
+    if (!_updateIslandsInProgress)
+        return std::unique_lock<std::recursive_mutex>();
+
+    return std::unique_lock<std::recursive_mutex>(_updateIslandsLock);
+}
+
+void Map::ExecuteAfterIslandUpdate(std::function<void()> action)
+{
+    if (!_updateIslandsInProgress)
+    {
+        action();
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_updateIslandsLock);
+    _updateIslandsDeferredActions.push_back(std::move(action));
+}
+
+bool Map::IsInCurrentUpdateIsland(CellCoord const& cellCoord) const
+{
+    if (!_updateIslandsInProgress)
+        return true;
+
+    if (UpdateIslandMap != this || !UpdateIslandCells)
+        return false;
+
+    return std::binary_search(UpdateIslandCells->begin(), UpdateIslandCells->end(), cellCoord.GetId());
+}
+
+bool Map::CanUpdateIslandsInParallel() const
+{
+    // instance and battleground scripts freely reach across the whole map
+    return sMapMgr->GetIslandUpdatePool() && !Instanceable();
+}
+
+uint32 Map::AddUpdateIslandSource(WorldObject* obj, uint32 link)
+{
+    // Check for valid position
+    if (!obj->IsPositionValid())
+        return link;
+
+    _updateIslandSources.push_back({ Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange()), link });
+    return uint32(_updateIslandSources.size() - 1);
+}
+
+void Map::UpdateIslands(uint32 diff)
+{
+    std::vector<UpdateIslandSource> sources;
+    sources.swap(_updateIslandSources);
+    if (sources.empty())
+        return;
+
+    std::vector<uint32> parent(sources.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    auto findRoot = [&parent](uint32 index)
+    {
+        while (parent[index] != index)
+            index = parent[index] = parent[parent[index]];
+        return index;
+    };
+
+    auto unite = [&](uint32 left, uint32 right)
+    {
+        left = findRoot(left);
+        right = findRoot(right);
+        if (left != right)
+            parent[std::max(left, right)] = std::min(left, right);
+    };
+
+    for (uint32 i = 0; i < sources.size(); ++i)
+        if (sources[i].Link < sources.size())
+            unite(i, sources[i].Link);
+
+    // objects in different islands must never be within visibility range of each other,
+    // sweep the areas along x and join all pairs that are closer than that
+    uint32 const margin = uint32(std::ceil(GetVisibilityRange() / SIZE_OF_GRID_CELL));
+
+    std::vector<uint32> byX(sources.size());
+    std::iota(byX.begin(), byX.end(), 0);
+    std::sort(byX.begin(), byX.end(), [&sources](uint32 left, uint32 right)
+    {
+        return sources[left].Area.low_bound.x_coord < sources[right].Area.low_bound.x_coord;
+    });
+
+    for (std::size_t i = 0; i < byX.size(); ++i)
+    {
+        CellArea const& area = sources[byX[i]].Area;
+        for (std::size_t j = i + 1; j < byX.size(); ++j)
+        {
+            CellArea const& other = sources[byX[j]].Area;
+            if (other.low_bound.x_coord > area.high_bound.x_coord + margin)
+                break;
+
+            if (other.low_bound.y_coord <= area.high_bound.y_coord + margin && area.low_bound.y_coord <= other.high_bound.y_coord + margin)
+                unite(byX[i], byX[j]);
+        }
+    }
+
+    // cells are marked here, on the map thread, so every cell belongs to exactly one island
+    std::vector<std::vector<uint32>> islands;
+    std::vector<std::size_t> islandIndex(sources.size(), std::numeric_limits<std::size_t>::max());
+    for (uint32 i = 0; i < sources.size(); ++i)
+    {
+        uint32 root = findRoot(i);
+        if (islandIndex[root] == std::numeric_limits<std::size_t>::max())
+        {
+            islandIndex[root] = islands.size();
+            islands.emplace_back();
+        }
+
+        std::vector<uint32>& cells = islands[islandIndex[root]];
+        CellArea const& area = sources[i].Area;
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                if (isCellMarked(cell_id))
+                    continue;
+
+                markCell(cell_id);
+                cells.push_back(cell_id);
+            }
+        }
+    }
+
+    auto updateCells = [this, diff](std::vector<uint32> const& cells)
+    {
+        Trinity::ObjectUpdater updater(diff);
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+
+        UpdateIslandMap = this;
+        UpdateIslandCells = &cells;
+
+        for (uint32 cell_id : cells)
+        {
+            Cell cell(CellCoord(cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP, cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            cell.SetNoCreate();
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+
+        UpdateIslandMap = nullptr;
+        UpdateIslandCells = nullptr;
+    };
+
+    if (islands.size() == 1)
+    {
+        updateCells(islands.front());
+        return;
+    }
+
+    // the largest island is updated on this thread, the rest is handed to the island pool
+    std::sort(islands.begin(), islands.end(), [](std::vector<uint32> const& left, std::vector<uint32> const& right)
+    {
+        return left.size() > right.size();
+    });
+
+    for (std::vector<uint32>& cells : islands)
+        std::sort(cells.begin(), cells.end());
+
+    std::mutex pendingLock;
+    std::condition_variable pendingCondition;
+    std::size_t pending = islands.size() - 1;
+
+    _updateIslandsInProgress = true;
+
+    for (std::size_t i = 1; i < islands.size(); ++i)
+    {
+        sMapMgr->GetIslandUpdatePool()->PostWork([&, i]()
+        {
+            updateCells(islands[i]);
+
+            std::lock_guard<std::mutex> lock(pendingLock);
+            if (!--pending)
+                pendingCondition.notify_one();
+        });
+    }
+
+    updateCells(islands.front());
+
+    std::unique_lock<std::mutex> lock(pendingLock);
+    while (pending)
+        pendingCondition.wait(lock);
+
+    _updateIslandsInProgress = false;
+
+    // changes reaching outside of their island are applied here, single threaded and in the order each island queued them
+    std::vector<std::function<void()>> actions;
+    actions.swap(_updateIslandsDeferredActions);
+    for (std::function<void()>& action : actions)
+        action();
+}
+
 void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
@@ -610,6 +865,12 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(uint32 t_diff)
 {
+    _queryCache.SetEnabled(sWorld->getBoolConfig(CONFIG_MAP_QUERY_CACHE));
+    _queryCache.Reset();
+
+    // grids read ahead by preload threads become visible only here, before anything of this map reads terrain
+    m_terrain->PublishPreparedGrids();
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -637,6 +898,9 @@ void Map::Update(uint32 t_diff)
     /// update active cells around players and active objects
     resetMarkedCells();
 
+    // with island updates the cells are only collected here and updated afterwards in UpdateIslands
+    bool const updateIslands = CanUpdateIslandsInParallel();
+
     Trinity::ObjectUpdater updater(t_diff);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
@@ -655,11 +919,26 @@ void Map::Update(uint32 t_diff)
         // update players at tick
         player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        // everything visited on behalf of this player must be updated in the player's island
+        uint32 island = std::numeric_limits<uint32>::max();
+        auto visitNearbyCellsOf = [&](WorldObject* obj)
+        {
+            if (!updateIslands)
+            {
+                VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+                return;
+            }
+
+            uint32 source = AddUpdateIslandSource(obj, island);
+            if (island == std::numeric_limits<uint32>::max())
+                island = source;
+        };
+
+        visitNearbyCellsOf(player);
 
         // If player is using far sight or mind vision, visit that object too
         if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+            visitNearbyCellsOf(viewPoint);
 
         // Handle updates for creatures in combat with player and are more than 60 yards away
         if (player->IsInCombat())
@@ -670,7 +949,7 @@ void Map::Update(uint32 t_diff)
                     if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
                         toVisit.push_back(unit);
             for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+                visitNearbyCellsOf(unit);
         }
 
         { // Update any creatures that own auras the player has applications of
@@ -682,7 +961,7 @@ void Map::Update(uint32 t_diff)
                         toVisit.insert(caster);
             }
             for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+                visitNearbyCellsOf(unit);
         }
 
         { // Update any creatures that own auras the player has applications of
@@ -694,7 +973,7 @@ void Map::Update(uint32 t_diff)
                         toVisit.insert(caster);
             }
             for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+                visitNearbyCellsOf(unit);
         }
     }
 
@@ -707,9 +986,15 @@ void Map::Update(uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        if (updateIslands)
+            AddUpdateIslandSource(obj, std::numeric_limits<uint32>::max());
+        else
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
 
+    if (updateIslands)
+        UpdateIslands(t_diff);
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         WorldObject* obj = *_transportsUpdateIter;
@@ -744,6 +1029,9 @@ void Map::Update(uint32 t_diff)
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
+    if (!_pathRequests.empty())
+        sPathRequestService.Submit(std::move(_pathRequests));
+
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
@@ -863,6 +1151,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     bool const inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -945,6 +1235,8 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 
     Cell old_cell(player->GetPositionX(), player->GetPositionY());
     Cell new_cell(x, y);
+    float dx = x - player->GetPositionX();
+    float dy = y - player->GetPositionY();
 
     player->Relocate(x, y, z, orientation);
     if (player->IsVehicle())
@@ -952,6 +1244,8 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 
     if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
     {
+        PreloadGridsAhead(x, y, dx, dy);
+
         TC_LOG_DEBUG("maps", "Player %s relocation grid[%u, %u]cell[%u, %u]->grid[%u, %u]cell[%u, %u]", player->GetName().c_str(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
 
         player->RemoveFromGrid();
@@ -1055,6 +1349,8 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1074,6 +1370,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1093,6 +1391,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1538,9 +1838,53 @@ float Map::GetGridHeight(PhaseShift const& phaseShift, float x, float y)
     return m_terrain->GetGridHeight(phaseShift, GetId(), x, y);
 }
 
+template<typename Query>
+float Map::GetCachedQueryResult(MapQueryType type, uint32 terrainMapId, PhaseShift const& phaseShift, uint32 flags, float searchDistance,
+    G3D::Vector3 const& start, G3D::Vector3 const& end, Query const& query) const
+{
+    if (!_queryCache.IsEnabled())
+        return query();
+
+    Optional<MapQueryCache::Key> key;
+    uint32 dynamicGeneration;
+    {
+        std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+        uint32 context = MapQueryCache::IsDynamic(type) ? _queryCache.GetPhaseShiftId(phaseShift) : terrainMapId;
+        key = MapQueryCache::MakeKey(type, context, flags, searchDistance, start, end);
+        if (!key)
+            return query();
+
+        float result;
+        if (_queryCache.Find(*key, result))
+            return result;
+
+        dynamicGeneration = _queryCache.GetDynamicGeneration();
+    }
+
+    // other islands keep going while this one hits vmaps
+    float result = query();
+
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+    _queryCache.Store(*key, result, dynamicGeneration);
+    return result;
+}
+
 float Map::GetStaticHeight(PhaseShift const& phaseShift, float x, float y, float z, bool checkVMap, float maxSearchDist)
 {
-    return m_terrain->GetStaticHeight(phaseShift, GetId(), x, y, z, checkVMap, maxSearchDist);
+    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x, y);
+    return GetCachedQueryResult(MapQueryType::StaticHeight, terrainMapId, phaseShift, checkVMap, maxSearchDist, { x, y, z }, G3D::Vector3::zero(), [&]()
+    {
+        return m_terrain->GetStaticHeight(phaseShift, GetId(), x, y, z, checkVMap, maxSearchDist);
+    });
+}
+
+float Map::GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist) const
+{
+    return GetCachedQueryResult(MapQueryType::GameObjectFloor, GetId(), phaseShift, 0, maxSearchDist, { x, y, z }, G3D::Vector3::zero(), [&]()
+    {
+        std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+        return _dynamicTree.getHeight(x, y, z, maxSearchDist, phaseShift);
+    });
 }
 
 float Map::GetWaterLevel(PhaseShift const& phaseShift, float x, float y)
@@ -1565,21 +1909,82 @@ float Map::GetWaterOrGroundLevel(PhaseShift const& phaseShift, float x, float y,
 
 bool Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
-    if ((checks & LINEOFSIGHT_CHECK_VMAP)
-      && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x1, y1), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
-    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
-      && !_dynamicTree.isInLineOfSight({x1, y1, z1}, {x2, y2, z2}, phaseShift))
-        return false;
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x1, y1);
+        float visible = GetCachedQueryResult(MapQueryType::StaticLineOfSight, terrainMapId, phaseShift, uint32(ignoreFlags), 0.0f, { x1, y1, z1 }, { x2, y2, z2 }, [&]()
+        {
+            return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapId, x1, y1, z1, x2, y2, z2, ignoreFlags) ? 1.0f : 0.0f;
+        });
+
+        if (visible == 0.0f)
+            return false;
+    }
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        float visible = GetCachedQueryResult(MapQueryType::DynamicLineOfSight, GetId(), phaseShift, 0, 0.0f, { x1, y1, z1 }, { x2, y2, z2 }, [&]()
+        {
+            std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+            return _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phaseShift) ? 1.0f : 0.0f;
+        });
+
+        if (visible == 0.0f)
+            return false;
+    }
     return true;
 }
 
+void Map::isInLineOfSight(PhaseShift const* const* phaseShifts, G3D::Vector3 const* starts, G3D::Vector3 const* ends, std::size_t count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) const
+{
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        std::vector<uint32> terrainMapIds(count);
+        for (std::size_t i = 0; i < count; ++i)
+            terrainMapIds[i] = PhasingHandler::GetTerrainMapId(*phaseShifts[i], GetId(), m_terrain.get(), starts[i].x, starts[i].y);
+
+        // segments are checked together per terrain map they start on, nearly always all of them share one
+        std::vector<bool> checked(count, false);
+        std::vector<bool> groupVisible;
+        std::vector<std::size_t> group;
+        for (std::size_t first = 0; first < count; ++first)
+        {
+            if (checked[first] || !visible[first])
+                continue;
+
+            group.clear();
+            groupVisible.assign(count, false);
+            for (std::size_t i = first; i < count; ++i)
+            {
+                if (!checked[i] && visible[i] && terrainMapIds[i] == terrainMapIds[first])
+                {
+                    checked[i] = true;
+                    groupVisible[i] = true;
+                    group.push_back(i);
+                }
+            }
+
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapIds[first], starts, ends, count, ignoreFlags, groupVisible);
+            for (std::size_t i : group)
+                visible[i] = groupVisible[i];
+        }
+    }
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+        for (std::size_t i = 0; i < count; ++i)
+            if (visible[i] && !_dynamicTree.isInLineOfSight(starts[i], ends[i], *phaseShifts[i]))
+                visible[i] = false;
+    }
+}
+
 bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     bool result = _dynamicTree.getObjectHitPos(startPos, dstPos, resultPos, modifyDist, phaseShift);
 
     rx = resultPos.x;
@@ -1777,22 +2182,70 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+void Map::AddUpdateObject(Object* obj)
+{
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+    obj->m_updateObjectIndex = _updateObjects.size();
+    _updateObjects.push_back(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+    // items are queued on their owner's map, which might not be this one anymore
+    if (obj->m_updateObjectIndex < _updateObjects.size() && _updateObjects[obj->m_updateObjectIndex] == obj)
+        _updateObjects[obj->m_updateObjectIndex] = nullptr;
+}
+
 void Map::SendObjectUpdates()
 {
+    if (_updateObjects.empty())
+    {
+        _objectUpdateSizeHints.clear();
+        return;
+    }
+
+    // Receivers of last tick are very likely to receive updates again, set up their update data
+    // with a buffer of the size they needed back then instead of growing it block by block
     UpdateDataMapType update_players;
+    update_players.reserve(_objectUpdateSizeHints.size());
+    if (!_objectUpdateSizeHints.empty())
+    {
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* player = itr->GetSource();
+            auto hint = _objectUpdateSizeHints.find(player->GetGUID());
+            if (hint == _objectUpdateSizeHints.end())
+                continue;
+
+            auto p = update_players.emplace(player, UpdateData(player->GetMapId()));
+            p.first->second.Reserve(hint->second);
+        }
+    }
 
-    while (!_updateObjects.empty())
+    // objects can be queued again while building the updates, those are handled in the same pass
+    for (std::size_t i = 0; i < _updateObjects.size(); ++i)
     {
-        Object* obj = *_updateObjects.begin();
+        Object* obj = _updateObjects[i];
+        if (!obj)
+            continue;
+
         ASSERT(obj->IsInWorld());
 
-        _updateObjects.erase(_updateObjects.begin());
+        _updateObjects[i] = nullptr;
         obj->BuildUpdate(update_players);
     }
 
+    _updateObjects.clear();
+    _objectUpdateSizeHints.clear();
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
+        if (!iter->second.HasData())
+            continue;
+
+        _objectUpdateSizeHints[iter->first->GetGUID()] = iter->second.GetDataSize();
         iter->second.BuildPacket(&packet);
         iter->first->SendDirectMessage(&packet);
         packet.clear();                                     // clean the string
@@ -2127,20 +2580,23 @@ void Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::Low
 bool Map::ShouldBeSpawnedOnGridLoad(SpawnObjectType type, ObjectGuid::LowType spawnId) const
 {
     ASSERT(SpawnData::TypeHasData(type));
+    return ShouldBeSpawnedOnGridLoad(ASSERT_NOTNULL(sObjectMgr->GetSpawnData(type, spawnId)));
+}
 
+bool Map::ShouldBeSpawnedOnGridLoad(SpawnData const* spawnData) const
+{
     // check if the object is on its respawn timer
-    if (GetRespawnTime(type, spawnId))
+    if (GetRespawnTime(spawnData->type, spawnData->spawnId))
         return false;
 
-    SpawnMetadata const* spawnData = ASSERT_NOTNULL(sObjectMgr->GetSpawnMetadata(type, spawnId));
     // check if the object is part of a spawn group
     SpawnGroupTemplateData const* spawnGroup = ASSERT_NOTNULL(spawnData->spawnGroupData);
     if (!(spawnGroup->flags & SPAWNGROUP_FLAG_SYSTEM))
         if (!IsSpawnGroupActive(spawnGroup->groupId))
             return false;
 
-    if (spawnData->ToSpawnData()->poolId)
-        if (!GetPoolData().IsSpawnedObject(type, spawnId))
+    if (spawnData->poolId)
+        if (!GetPoolData().IsSpawnedObject(spawnData->type, spawnData->spawnId))
             return false;
 
     return true;
@@ -2344,6 +2800,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     obj->SetDestroyedObject(true);
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
@@ -2359,6 +2817,8 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2496,6 +2956,8 @@ bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     AddToActiveHelper(obj);
 
     Optional<Position> respawnLocation;
@@ -2535,6 +2997,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     RemoveFromActiveHelper(obj);
 
     Optional<Position> respawnLocation;
@@ -3140,26 +3604,31 @@ Player* Map::GetPlayer(ObjectGuid const& guid)
 
 AreaTrigger* Map::GetAreaTrigger(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<AreaTrigger>(guid);
 }
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<Creature>(guid);
 }
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
 Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     auto const bounds = GetCreatureBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3174,6 +3643,7 @@ Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 
 GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     auto const bounds = GetGameObjectBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3188,11 +3658,13 @@ GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3213,6 +3685,8 @@ void Map::UpdateIteratorBack(Player* player)
 
 void Map::SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans, bool startup)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
+
     SpawnMetadata const* data = sObjectMgr->GetSpawnMetadata(type, spawnId);
     if (!data)
     {
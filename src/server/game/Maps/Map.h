@@ -25,6 +25,7 @@
 #include "GridDefines.h"
 #include "GridRefManager.h"
 #include "MapDefines.h"
+#include "MapQueryCache.h"
 #include "MapRefManager.h"
 #include "MPSCQueue.h"
 #include "ObjectGuid.h"
@@ -36,6 +37,7 @@
 #include "Weather.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include <bitset>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -60,6 +62,7 @@ class WorldObject;
 class WorldPacket;
 struct MapDifficulty;
 struct MapEntry;
+struct PathRequest;
 struct Position;
 struct ScriptAction;
 struct ScriptInfo;
@@ -192,6 +195,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32);
 
+        // Serializes changes to map wide containers while update islands run in parallel, does not lock otherwise
+        std::unique_lock<std::recursive_mutex> AcquireIslandUpdateLock() const;
+
+        // Runs action right away, or after all update islands joined when called while they are updated in parallel
+        // (pool updates and script scheduling)
+        void ExecuteAfterIslandUpdate(std::function<void()> action);
+
+        // Poly path searches collected during Update() are handed to the path request service together when it ends
+        void QueuePathRequest(std::shared_ptr<PathRequest> request) { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); _pathRequests.push_back(std::move(request)); }
+
+        // wall time of the last Update() call in microseconds, used by MapUpdater to dispatch expensive maps first
+        uint32 GetLastUpdateDuration() const { return m_lastUpdateDuration; }
+        void SetLastUpdateDuration(uint32 duration) { m_lastUpdateDuration = duration; }
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -218,6 +235,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool GetUnloadLock(GridCoord const& p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(GridCoord const& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void LoadGrid(float x, float y);
+        // Queues terrain of the grids ahead of an object moving in direction (dx, dy) for background loading
+        void PreloadGridsAhead(float x, float y, float dx, float dy);
         void LoadAllCells();
         bool UnloadGrid(NGridType& ngrid, bool pForce);
         void GridMarkNoUnload(uint32 x, uint32 y);
@@ -326,8 +345,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(NGridType const& ngrid) const;
 
-        void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
-        void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
+        void AddWorldObject(WorldObject* obj) { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); i_worldObjects.insert(obj); }
+        void RemoveWorldObject(WorldObject* obj) { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); i_worldObjects.erase(obj); }
 
         void SendToPlayers(WorldPacket const* data) const;
 
@@ -409,14 +428,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
         bool isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // Checks many segments at once, each with the phase shift of the object it starts at. Only segments still marked in visible are checked, blocked ones are cleared
+        void isInLineOfSight(PhaseShift const* const* phaseShifts, G3D::Vector3 const* starts, G3D::Vector3 const* ends, std::size_t count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, std::vector<bool>& visible) const;
         void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-        bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
-        float GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
-        {
-            return _dynamicTree.getHeight(x, y, z, maxSearchDist, phaseShift);
-        }
+        void RemoveGameObjectModel(const GameObjectModel& model) { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); _dynamicTree.remove(model); _queryCache.InvalidateDynamic(); }
+        void InsertGameObjectModel(const GameObjectModel& model) { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); _dynamicTree.insert(model); _queryCache.InvalidateDynamic(); }
+        bool ContainsGameObjectModel(const GameObjectModel& model) const { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); return _dynamicTree.contains(model);}
+        // Must be called when the collision of a gameobject model in the map is toggled
+        void InvalidateGameObjectModelQueries() { std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock(); _queryCache.InvalidateDynamic(); }
+        float GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         virtual uint32 GetOwnerGuildId(uint32 /*team*/ = TEAM_OTHER) const { return 0; }
@@ -467,6 +487,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         inline ObjectGuid::LowType GenerateLowGuid()
         {
             static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+            std::unique_lock<std::recursive_mutex> lock = AcquireIslandUpdateLock();
             return GetGuidSequenceGenerator<high>().Generate();
         }
 
@@ -477,15 +498,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
             return GetGuidSequenceGenerator<high>().GetNextAfterMaxUsed();
         }
 
-        void AddUpdateObject(Object* obj)
-        {
-            _updateObjects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            _updateObjects.erase(obj);
-        }
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
 
     private:
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
@@ -535,6 +549,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void ScheduleScriptActions(std::vector<std::pair<time_t, ScriptAction>> actions, bool immediate);
 
         void SendObjectUpdates();
 
@@ -544,6 +559,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint8 i_spawnMode;
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
+        uint32 m_lastUpdateDuration;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
 
@@ -582,6 +598,33 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(uint32 diff);
 
+        // Island updates: cells around players and active objects are collected first, grouped into
+        // islands that are further apart than the visibility range and then updated on MapManager's island pool
+        struct UpdateIslandSource
+        {
+            CellArea Area;
+            uint32 Link;                    // index of a source that must end up in the same island
+        };
+
+        bool CanUpdateIslandsInParallel() const;
+        uint32 AddUpdateIslandSource(WorldObject* obj, uint32 link);
+        void UpdateIslands(uint32 diff);
+        bool IsInCurrentUpdateIsland(CellCoord const& cellCoord) const;
+
+        std::vector<UpdateIslandSource> _updateIslandSources;
+        bool _updateIslandsInProgress;
+        mutable std::recursive_mutex _updateIslandsLock;
+        std::vector<std::function<void()>> _updateIslandsDeferredActions;
+
+        std::vector<std::shared_ptr<PathRequest>> _pathRequests;
+
+        // height and line of sight results of the current update
+        template<typename Query>
+        float GetCachedQueryResult(MapQueryType type, uint32 terrainMapId, PhaseShift const& phaseShift, uint32 flags, float searchDistance,
+            G3D::Vector3 const& start, G3D::Vector3 const& end, Query const& query) const;
+
+        mutable MapQueryCache _queryCache;
+
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
@@ -625,6 +668,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         size_t DespawnAll(SpawnObjectType type, ObjectGuid::LowType spawnId);
 
         bool ShouldBeSpawnedOnGridLoad(SpawnObjectType type, ObjectGuid::LowType spawnId) const;
+        bool ShouldBeSpawnedOnGridLoad(SpawnData const* data) const;
         template <typename T> bool ShouldBeSpawnedOnGridLoad(ObjectGuid::LowType spawnId) const { return ShouldBeSpawnedOnGridLoad(SpawnData::TypeFor<T>, spawnId); }
 
         SpawnGroupTemplateData const* GetSpawnGroupData(uint32 groupId) const;
@@ -734,7 +778,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_map<ObjectGuid, Corpse*> _corpsesByPlayer;
         std::unordered_set<Corpse*> _corpseBones;
 
-        std::unordered_set<Object*> _updateObjects;
+        // Objects with pending value changes, removed entries are nulled out until the list is flushed by SendObjectUpdates
+        std::vector<Object*> _updateObjects;
+        // Size of the update data each player received last tick, used to reserve its buffer up front
+        std::unordered_map<ObjectGuid, std::size_t> _objectUpdateSizeHints;
 
         MPSCQueue<FarSpellCallback> _farSpellCallbacks;
 
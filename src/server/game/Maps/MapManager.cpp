@@ -25,10 +25,12 @@
 #include "Language.h"
 #include "Log.h"
 #include "Map.h"
+#include "MapQueryCache.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "ThreadPool.h"
 #include "World.h"
 #include "WorldStateMgr.h"
 #include "WorldPacket.h"
@@ -53,6 +55,10 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    // Start island pool if needed - updates distant parts of a single continent in parallel
+    if (uint32 islandThreads = sWorld->getIntConfig(CONFIG_MAP_ISLAND_UPDATE_THREADS))
+        _islandUpdatePool = std::make_unique<Trinity::ThreadPool>(islandThreads);
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -371,6 +377,8 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    MapQueryCache::UpdateMetrics();
+
     i_timer.SetCurrent(0);
 }
 
@@ -411,6 +419,12 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (_islandUpdatePool)
+    {
+        _islandUpdatePool->Join();
+        _islandUpdatePool.reset();
+    }
+
     Map::DeleteStateMachine();
 }
 
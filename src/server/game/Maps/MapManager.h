@@ -35,6 +35,11 @@ class Map;
 class Player;
 enum Difficulty : uint8;
 
+namespace Trinity
+{
+    class ThreadPool;
+}
+
 class TC_GAME_API MapManager
 {
         MapManager();
@@ -113,6 +118,7 @@ class TC_GAME_API MapManager
         void FreeInstanceId(uint32 instanceId);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        Trinity::ThreadPool* GetIslandUpdatePool() const { return _islandUpdatePool.get(); }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
@@ -148,6 +154,7 @@ class TC_GAME_API MapManager
         std::unique_ptr<InstanceIds> _freeInstanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        std::unique_ptr<Trinity::ThreadPool> _islandUpdatePool;
 
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
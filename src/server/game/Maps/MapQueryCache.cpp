@@ -0,0 +1,143 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapQueryCache.h"
+#include "Metric.h"
+#include <G3D/Vector3.h>
+#include <algorithm>
+#include <cmath>
+
+std::atomic<uint32> MapQueryCache::_hits(0);
+std::atomic<uint32> MapQueryCache::_misses(0);
+std::atomic<uint32> MapQueryCache::_invalidations(0);
+
+bool MapQueryCache::Key::operator==(Key const& right) const
+{
+    return Type == right.Type && Context == right.Context && Flags == right.Flags && SearchDistance == right.SearchDistance
+        && std::equal(std::begin(Coords), std::end(Coords), std::begin(right.Coords));
+}
+
+std::size_t MapQueryCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hash = std::hash<uint64>()((uint64(key.Context) << 32) | key.Flags);
+    hash ^= std::hash<uint32>()(uint32(key.Type)) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.SearchDistance) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    for (int32 coord : key.Coords)
+        hash ^= std::hash<int32>()(coord) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+MapQueryCache::MapQueryCache() : _dynamicGeneration(0), _enabled(false) { }
+
+void MapQueryCache::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!_enabled)
+        Reset();
+}
+
+void MapQueryCache::Reset()
+{
+    _staticResults.clear();
+    _dynamicResults.clear();
+    _phaseShifts.clear();
+}
+
+void MapQueryCache::InvalidateDynamic()
+{
+    ++_dynamicGeneration;
+    if (_dynamicResults.empty())
+        return;
+
+    _dynamicResults.clear();
+    ++_invalidations;
+}
+
+uint32 MapQueryCache::GetPhaseShiftId(PhaseShift const& phaseShift)
+{
+    // there are only a few different phase shifts around within one map update
+    auto itr = std::find_if(_phaseShifts.begin(), _phaseShifts.end(), [&phaseShift](PhaseShift const& known)
+    {
+        return known.HasSameVisibility(phaseShift);
+    });
+
+    if (itr != _phaseShifts.end())
+        return uint32(std::distance(_phaseShifts.begin(), itr));
+
+    _phaseShifts.push_back(phaseShift);
+    return uint32(_phaseShifts.size() - 1);
+}
+
+Optional<MapQueryCache::Key> MapQueryCache::MakeKey(MapQueryType type, uint32 context, uint32 flags, float searchDistance, G3D::Vector3 const& start, G3D::Vector3 const& end)
+{
+    // far beyond any map, also keeps the rounded coordinates within int32
+    float const maxCoord = 1.0e6f;
+
+    Key key;
+    key.Type = type;
+    key.Context = context;
+    key.Flags = flags;
+    key.SearchDistance = searchDistance;
+
+    float const coords[6] = { start.x, start.y, start.z, end.x, end.y, end.z };
+    for (int i = 0; i < 6; ++i)
+    {
+        if (!std::isfinite(coords[i]) || std::fabs(coords[i]) > maxCoord)
+            return {};
+
+        key.Coords[i] = int32(std::lround(coords[i] * PRECISION));
+    }
+
+    return key;
+}
+
+bool MapQueryCache::Find(Key const& key, float& result) const
+{
+    ResultContainer const& results = IsDynamic(key.Type) ? _dynamicResults : _staticResults;
+    auto itr = results.find(key);
+    if (itr == results.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    result = itr->second;
+    ++_hits;
+    return true;
+}
+
+void MapQueryCache::Store(Key const& key, float result, uint32 dynamicGeneration)
+{
+    if (!IsDynamic(key.Type))
+    {
+        _staticResults[key] = result;
+        return;
+    }
+
+    // the models changed while the result was computed
+    if (dynamicGeneration != _dynamicGeneration)
+        return;
+
+    _dynamicResults[key] = result;
+}
+
+void MapQueryCache::UpdateMetrics()
+{
+    TC_METRIC_VALUE("map_query_cache_hits", _hits.exchange(0));
+    TC_METRIC_VALUE("map_query_cache_misses", _misses.exchange(0));
+    TC_METRIC_VALUE("map_query_cache_invalidations", _invalidations.exchange(0));
+}
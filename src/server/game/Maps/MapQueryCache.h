@@ -0,0 +1,109 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MapQueryCache_h__
+#define MapQueryCache_h__
+
+#include "Define.h"
+#include "Optional.h"
+#include "PhaseShift.h"
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace G3D
+{
+    class Vector3;
+}
+
+enum class MapQueryType : uint8
+{
+    StaticHeight,           // terrain and vmap height, keyed by terrain map id
+    GameObjectFloor,        // gameobject model height, keyed by phase shift
+    StaticLineOfSight,      // vmap line of sight, keyed by terrain map id
+    DynamicLineOfSight      // gameobject model line of sight, keyed by phase shift
+};
+
+/**
+* Remembers height and line of sight results of one map update, so the same lookups repeated by spells, AI and
+* movement within a tick hit the terrain, vmaps and gameobject models only once. Positions are rounded to
+* 1/PRECISION yards. Everything is dropped when the next map update starts, results depending on gameobject
+* models also whenever a model is added, removed or has its collision toggled.
+*
+* Not thread safe, the map guards it with its island update lock.
+*/
+class TC_GAME_API MapQueryCache
+{
+public:
+    static constexpr float PRECISION = 64.0f;
+
+    struct Key
+    {
+        MapQueryType Type;
+        uint32 Context;             // terrain map id or phase shift id
+        uint32 Flags;
+        float SearchDistance;
+        int32 Coords[6];
+
+        bool operator==(Key const& right) const;
+    };
+
+    MapQueryCache();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return _enabled; }
+
+    // Starts a new map update
+    void Reset();
+    // Gameobject models changed, drops their results
+    void InvalidateDynamic();
+    uint32 GetDynamicGeneration() const { return _dynamicGeneration; }
+
+    // Small per tick id of phase shifts with the same visibility, for keys of gameobject model queries
+    uint32 GetPhaseShiftId(PhaseShift const& phaseShift);
+
+    // Keys are only made of finite positions inside the range of quantized coordinates
+    static Optional<Key> MakeKey(MapQueryType type, uint32 context, uint32 flags, float searchDistance, G3D::Vector3 const& start, G3D::Vector3 const& end);
+
+    bool Find(Key const& key, float& result) const;
+    // dynamicGeneration is the generation the result was computed in, outdated gameobject model results are not stored
+    void Store(Key const& key, float result, uint32 dynamicGeneration);
+
+    static bool IsDynamic(MapQueryType type) { return type == MapQueryType::GameObjectFloor || type == MapQueryType::DynamicLineOfSight; }
+
+    static void UpdateMetrics();
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    typedef std::unordered_map<Key, float, KeyHash> ResultContainer;
+
+    ResultContainer _staticResults;
+    ResultContainer _dynamicResults;
+    std::vector<PhaseShift> _phaseShifts;
+    uint32 _dynamicGeneration;
+    bool _enabled;
+
+    static std::atomic<uint32> _hits;
+    static std::atomic<uint32> _misses;
+    static std::atomic<uint32> _invalidations;
+};
+
+#endif // MapQueryCache_h__
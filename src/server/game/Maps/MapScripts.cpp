@@ -47,6 +47,8 @@ void Map::ScriptsStart(std::map<uint32, std::multimap<uint32, ScriptInfo>> const
     ///- Schedule script execution for all scripts in the script map
     ScriptMap const* s2 = &(s->second);
     bool immedScript = false;
+    std::vector<std::pair<time_t, ScriptAction>> actions;
+    actions.reserve(s2->size());
     for (ScriptMap::const_iterator iter = s2->begin(); iter != s2->end(); ++iter)
     {
         ScriptAction sa;
@@ -55,19 +57,12 @@ void Map::ScriptsStart(std::map<uint32, std::multimap<uint32, ScriptInfo>> const
         sa.ownerGUID  = ownerGUID;
 
         sa.script = &iter->second;
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(GameTime::GetGameTime() + iter->first), sa));
+        actions.emplace_back(time_t(GameTime::GetGameTime() + iter->first), sa);
         if (iter->first == 0)
             immedScript = true;
-
-        sMapMgr->IncreaseScheduledScriptsCount();
-    }
-    ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !i_scriptLock)
-    {
-        i_scriptLock = true;
-        ScriptsProcess();
-        i_scriptLock = false;
     }
+
+    ScheduleScriptActions(std::move(actions), immedScript);
 }
 
 void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target)
@@ -85,17 +80,31 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID  = ownerGUID;
 
     sa.script = &script;
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(GameTime::GetGameTime() + delay), sa));
 
-    sMapMgr->IncreaseScheduledScriptsCount();
+    std::vector<std::pair<time_t, ScriptAction>> actions;
+    actions.emplace_back(time_t(GameTime::GetGameTime() + delay), sa);
+    ScheduleScriptActions(std::move(actions), delay == 0);
+}
 
-    ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !i_scriptLock)
+void Map::ScheduleScriptActions(std::vector<std::pair<time_t, ScriptAction>> actions, bool immediate)
+{
+    // the schedule is map wide, scripts started from update islands are only queued once the islands joined
+    ExecuteAfterIslandUpdate([this, actions = std::move(actions), immediate]()
     {
-        i_scriptLock = true;
-        ScriptsProcess();
-        i_scriptLock = false;
-    }
+        for (std::pair<time_t, ScriptAction> const& action : actions)
+        {
+            m_scriptSchedule.insert(ScriptScheduleMap::value_type(action.first, action.second));
+            sMapMgr->IncreaseScheduledScriptsCount();
+        }
+
+        ///- If one of the effects should be immediate, launch the script execution
+        if (immediate && !i_scriptLock)
+        {
+            i_scriptLock = true;
+            ScriptsProcess();
+            i_scriptLock = false;
+        }
+    });
 }
 
 // Helpers for ScriptProcess method.
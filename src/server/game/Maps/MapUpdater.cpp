@@ -17,10 +17,11 @@
 
 #include "MapUpdater.h"
 #include "Map.h"
+#include "Metric.h"
 
+#include <chrono>
 #include <mutex>
 
-
 class MapUpdateRequest
 {
     private:
@@ -36,18 +37,27 @@ class MapUpdateRequest
         {
         }
 
+        uint32 GetExpectedCost() const
+        {
+            return m_map.GetLastUpdateDuration();
+        }
+
         void call()
         {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
             m_map.Update (m_diff);
+            m_map.SetLastUpdateDuration(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
             m_updater.update_finished();
         }
 };
 
 void MapUpdater::activate(size_t num_threads)
 {
+    _queue = std::make_unique<Trinity::WorkStealingQueue<MapUpdateRequest*>>(num_threads);
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -57,7 +67,7 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    _queue->Cancel();
 
     for (auto& thread : _workerThreads)
     {
@@ -67,12 +77,25 @@ void MapUpdater::deactivate()
 
 void MapUpdater::wait()
 {
+    std::vector<MapUpdateRequest*> requests;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        requests.swap(_scheduledRequests);
+    }
+
+    // maps that took longest to update during the previous tick are handed out first,
+    // workers that run out of work steal the cheap leftovers from the others
+    if (!requests.empty())
+        _queue->Distribute(requests, [](MapUpdateRequest const* request) { return request->GetExpectedCost(); });
+
     std::unique_lock<std::mutex> lock(_lock);
 
     while (pending_requests > 0)
         _condition.wait(lock);
 
     lock.unlock();
+
+    TC_METRIC_VALUE("map_update_steals", uint32(_queue->ResetStealCount()));
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
@@ -81,7 +104,7 @@ void MapUpdater::schedule_update(Map& map, uint32 diff)
 
     ++pending_requests;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+    _scheduledRequests.push_back(new MapUpdateRequest(map, *this, diff));
 }
 
 bool MapUpdater::activated()
@@ -98,16 +121,20 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t index)
 {
     while (1)
     {
         MapUpdateRequest* request = nullptr;
 
-        _queue.WaitAndPop(request);
+        if (!_queue->WaitAndPop(index, request))
+            return;
 
         if (_cancelationToken)
+        {
+            delete request;
             return;
+        }
 
         request->call();
 
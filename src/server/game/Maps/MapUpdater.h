@@ -22,7 +22,9 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <memory>
+#include <vector>
+#include "WorkStealingQueue.h"
 
 class MapUpdateRequest;
 class Map;
@@ -36,6 +38,8 @@ class TC_GAME_API MapUpdater
 
         friend class MapUpdateRequest;
 
+        // Requests are collected until wait() is called, which dispatches them to the workers
+        // ordered by the previous update duration of their map (longest first)
         void schedule_update(Map& map, uint32 diff);
 
         void wait();
@@ -48,7 +52,8 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        std::unique_ptr<Trinity::WorkStealingQueue<MapUpdateRequest*>> _queue;
+        std::vector<MapUpdateRequest*> _scheduledRequests;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
@@ -59,7 +64,7 @@ class TC_GAME_API MapUpdater
 
         void update_finished();
 
-        void WorkerThread();
+        void WorkerThread(size_t index);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -22,7 +22,9 @@
 #include "GridMap.h"
 #include "Log.h"
 #include "Memory.h"
+#include "Metric.h"
 #include "MMapFactory.h"
+#include "PathRequestService.h"
 #include "PhasingHandler.h"
 #include "Random.h"
 #include "ScriptMgr.h"
@@ -32,13 +34,36 @@
 #include "World.h"
 #include <G3D/g3dmath.h>
 
+// File contents of a grid read by a preload thread. Nothing of it is visible to the map before it is published
+struct TerrainInfo::PreparedGrid
+{
+    PreparedGrid(int32 gx, int32 gy) : GridX(gx), GridY(gy), MapLoadResult(GridMap::LoadResult::FileDoesNotExist) { }
+    ~PreparedGrid()
+    {
+        // the vmap tile acquired them again when it was published
+        for (std::string const& model : VMapModels)
+            VMAP::VMapFactory::createOrGetVMapManager()->releaseModelInstance(model);
+    }
+
+    int32 GridX;
+    int32 GridY;
+    std::unique_ptr<GridMap> Map;
+    GridMap::LoadResult MapLoadResult;
+    std::vector<std::string> VMapModels;
+    MMAP::MMapTileData MMapTile;
+    std::vector<std::unique_ptr<PreparedGrid>> Children;   // same order as _childTerrain
+    std::chrono::steady_clock::time_point QueueTime;        // when the preload of the grid was requested
+};
+
 TerrainInfo::TerrainInfo(uint32 mapId) : _mapId(mapId), _parentTerrain(nullptr), _cleanupTimer(randtime(CleanupInterval / 2, CleanupInterval).count())
 {
 }
 
 TerrainInfo::~TerrainInfo()
 {
+    _preparedGrids.clear();
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId());
+    sPathRequestService.CancelMap(GetId());
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId());
 }
 
@@ -159,23 +184,112 @@ void TerrainInfo::LoadMapAndVMap(int32 gx, int32 gy)
     if (++_referenceCountFromMap[gx][gy] != 1)    // check if already loaded
         return;
 
+    std::unique_ptr<PreparedGrid> prepared = TakePreparedGrid(gx, gy);
+
     std::lock_guard<std::mutex> lock(_loadMutex);
-    LoadMapAndVMapImpl(gx, gy);
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])     // might have been published already
+        LoadMapAndVMapImpl(gx, gy, prepared.get());
 }
 
-void TerrainInfo::LoadMapAndVMapImpl(int32 gx, int32 gy)
+std::unique_ptr<TerrainInfo::PreparedGrid> TerrainInfo::ReadGrid(int32 gx, int32 gy) const
 {
-    LoadMap(gx, gy);
-    LoadVMap(gx, gy);
-    LoadMMap(gx, gy);
+    std::unique_ptr<PreparedGrid> prepared = std::make_unique<PreparedGrid>(gx, gy);
+
+    std::string fileName = Trinity::StringFormat("%smaps/%03u%02u%02u.map", sWorld->GetDataPath().c_str(), GetId(), gx, gy);
+    prepared->Map = std::make_unique<GridMap>();
+    prepared->MapLoadResult = prepared->Map->loadData(fileName.c_str(), sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED));
+    if (prepared->MapLoadResult != GridMap::LoadResult::Ok)
+        prepared->Map = nullptr;
+
+    prepared->VMapModels = VMAP::VMapFactory::createOrGetVMapManager()->acquireTileModels((sWorld->GetDataPath() + "vmaps").c_str(), GetId(), gx, gy);
+
+    if (sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS))
+        MMAP::MMapFactory::createOrGetMMapManager()->readTile(sWorld->GetDataPath(), GetId(), gx, gy, prepared->MMapTile);
 
     for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
-        childTerrain->LoadMapAndVMapImpl(gx, gy);
+        prepared->Children.push_back(childTerrain->ReadGrid(gx, gy));
+
+    return prepared;
+}
+
+std::unique_ptr<TerrainInfo::PreparedGrid> TerrainInfo::TakePreparedGrid(int32 gx, int32 gy)
+{
+    std::lock_guard<std::mutex> lock(_preparedGridsLock);
+    auto itr = std::find_if(_preparedGrids.begin(), _preparedGrids.end(), [gx, gy](std::unique_ptr<PreparedGrid> const& prepared)
+    {
+        return prepared->GridX == gx && prepared->GridY == gy;
+    });
+
+    if (itr == _preparedGrids.end())
+        return nullptr;
+
+    std::unique_ptr<PreparedGrid> prepared = std::move(*itr);
+    _preparedGrids.erase(itr);
+    return prepared;
+}
+
+bool TerrainInfo::PrepareMapAndVMap(int32 gx, int32 gy, std::chrono::steady_clock::time_point queueTime)
+{
+    auto isPrepared = [this, gx, gy]()
+    {
+        return std::any_of(_preparedGrids.begin(), _preparedGrids.end(), [gx, gy](std::unique_ptr<PreparedGrid> const& prepared)
+        {
+            return prepared->GridX == gx && prepared->GridY == gy;
+        });
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(_preparedGridsLock);
+        if (isPrepared())
+            return false;
+    }
+
+    // file IO only, the map thread adds the grid to everything it reads from
+    std::unique_ptr<PreparedGrid> prepared = ReadGrid(gx, gy);
+    prepared->QueueTime = queueTime;
+
+    std::lock_guard<std::mutex> lock(_preparedGridsLock);
+    if (isPrepared())
+        return false;
+
+    _preparedGrids.push_back(std::move(prepared));
+    return true;
+}
+
+void TerrainInfo::PublishPreparedGrids()
+{
+    std::vector<std::unique_ptr<PreparedGrid>> preparedGrids;
+    {
+        std::lock_guard<std::mutex> lock(_preparedGridsLock);
+        if (_preparedGrids.empty())
+            return;
+
+        preparedGrids.swap(_preparedGrids);
+    }
+
+    std::lock_guard<std::mutex> lock(_loadMutex);
+    for (std::unique_ptr<PreparedGrid> const& prepared : preparedGrids)
+        if (!_loadedGrids[GetBitsetIndex(prepared->GridX, prepared->GridY)])
+            LoadMapAndVMapImpl(prepared->GridX, prepared->GridY, prepared.get());
+}
+
+void TerrainInfo::LoadMapAndVMapImpl(int32 gx, int32 gy, PreparedGrid* prepared /*= nullptr*/)
+{
+    LoadMap(gx, gy, prepared);
+    LoadVMap(gx, gy);
+    LoadMMap(gx, gy, prepared);
+
+    for (std::size_t i = 0; i < _childTerrain.size(); ++i)
+        _childTerrain[i]->LoadMapAndVMapImpl(gx, gy, prepared ? prepared->Children[i].get() : nullptr);
 
     _loadedGrids[GetBitsetIndex(gx, gy)] = true;
+
+    // preloads are queued for the parent terrain only, its children are published along with it
+    if (prepared && !_parentTerrain)
+        TC_METRIC_VALUE("terrain_preload_latency", uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - prepared->QueueTime).count()));
 }
 
-void TerrainInfo::LoadMap(int32 gx, int32 gy)
+void TerrainInfo::LoadMap(int32 gx, int32 gy, PreparedGrid* prepared)
 {
     if (_gridMap[gx][gy])
         return;
@@ -185,10 +299,21 @@ void TerrainInfo::LoadMap(int32 gx, int32 gy)
 
     // map file name
     std::string fileName = Trinity::StringFormat("%smaps/%03u%02u%02u.map", sWorld->GetDataPath().c_str(), GetId(), gx, gy);
-    TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
-    // loading data
-    std::unique_ptr<GridMap> gridMap = std::make_unique<GridMap>();
-    GridMap::LoadResult gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    std::unique_ptr<GridMap> gridMap;
+    GridMap::LoadResult gridMapLoadResult;
+    if (prepared)
+    {
+        gridMap = std::move(prepared->Map);
+        gridMapLoadResult = prepared->MapLoadResult;
+    }
+    else
+    {
+        TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
+        // loading data
+        gridMap = std::make_unique<GridMap>();
+        gridMapLoadResult = gridMap->loadData(fileName.c_str(), sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED));
+    }
+
     if (gridMapLoadResult == GridMap::LoadResult::Ok)
         _gridMap[gx][gy] = std::move(gridMap);
     else
@@ -221,12 +346,12 @@ void TerrainInfo::LoadVMap(int32 gx, int32 gy)
     }
 }
 
-void TerrainInfo::LoadMMap(int32 gx, int32 gy)
+void TerrainInfo::LoadMMap(int32 gx, int32 gy, PreparedGrid* prepared)
 {
     if (!DisableMgr::IsPathfindingEnabled(GetId()))
         return;
 
-    bool mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap(sWorld->GetDataPath(), GetId(), gx, gy);
+    bool mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap(sWorld->GetDataPath(), GetId(), gx, gy, prepared ? &prepared->MMapTile : nullptr);
 
     if (mmapLoadResult)
         TC_LOG_DEBUG("mmaps.tiles", "MMAP loaded name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
@@ -261,8 +386,9 @@ GridMap* TerrainInfo::GetGrid(uint32 mapId, float x, float y, bool loadIfMissing
     // ensure GridMap is loaded
     if (!_loadedGrids[GetBitsetIndex(gx, gy)] && loadIfMissing)
     {
+        std::unique_ptr<PreparedGrid> prepared = TakePreparedGrid(gx, gy);
         std::lock_guard<std::mutex> lock(_loadMutex);
-        LoadMapAndVMapImpl(gx, gy);
+        LoadMapAndVMapImpl(gx, gy, prepared.get());
     }
 
     GridMap* grid = _gridMap[gx][gy].get();
@@ -286,6 +412,7 @@ void TerrainInfo::CleanUpGrids(uint32 diff)
         return;
 
     // delete those GridMap objects which have refcount = 0
+    std::lock_guard<std::mutex> lock(_loadMutex);
     for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
             if (_loadedGrids[GetBitsetIndex(x, y)] && !_referenceCountFromMap[x][y])
@@ -711,9 +838,12 @@ float TerrainInfo::GetWaterOrGroundLevel(PhaseShift const& phaseShift, uint32 ma
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
-TerrainMgr::TerrainMgr() = default;
+TerrainMgr::TerrainMgr() : _preloadQueueSize(0), _preloadShutdown(false), _droppedPreloads(0) { }
 
-TerrainMgr::~TerrainMgr() = default;
+TerrainMgr::~TerrainMgr()
+{
+    StopPreloading();
+}
 
 TerrainMgr& TerrainMgr::Instance()
 {
@@ -754,17 +884,131 @@ std::shared_ptr<TerrainInfo> TerrainMgr::LoadTerrain(uint32 mapId)
 
 void TerrainMgr::UnloadAll()
 {
+    StopPreloading();
+    _preloadReleasedTerrain.clear();
     _terrainMaps.clear();
 }
 
 void TerrainMgr::Update(uint32 diff)
 {
+    if (IsPreloadingEnabled())
+    {
+        std::vector<std::shared_ptr<TerrainInfo>> released;
+        std::size_t queued;
+        {
+            std::lock_guard<std::mutex> lock(_preloadLock);
+            released.swap(_preloadReleasedTerrain);
+            queued = _preloadQueue.size();
+        }
+
+        TC_METRIC_VALUE("terrain_preload_queue_size", uint32(queued));
+        TC_METRIC_VALUE("terrain_preload_dropped", _droppedPreloads.exchange(0));
+    }
+
     // global garbage collection
     for (auto& [mapId, terrainRef] : _terrainMaps)
         if (std::shared_ptr<TerrainInfo> terrain = terrainRef.lock())
             terrain->CleanUpGrids(diff);
 }
 
+void TerrainMgr::StartPreloading(uint32 threads, uint32 queueSize)
+{
+    StopPreloading();
+
+    if (!threads || !queueSize)
+        return;
+
+    _preloadQueueSize = queueSize;
+    _preloadQueue.reserve(queueSize + 1);
+    _preloadShutdown = false;
+    for (uint32 i = 0; i < threads; ++i)
+        _preloadThreads.emplace_back(&TerrainMgr::PreloadThread, this);
+}
+
+void TerrainMgr::StopPreloading()
+{
+    {
+        std::lock_guard<std::mutex> lock(_preloadLock);
+        _preloadShutdown = true;
+        _preloadQueue.clear();
+    }
+
+    _preloadCondition.notify_all();
+
+    for (std::thread& thread : _preloadThreads)
+        thread.join();
+
+    _preloadThreads.clear();
+}
+
+void TerrainMgr::QueuePreload(std::shared_ptr<TerrainInfo> const& terrain, int32 gx, int32 gy, float distance)
+{
+    if (!IsPreloadingEnabled() || terrain->IsMapAndVMapLoaded(gx, gy))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_preloadLock);
+        if (_preloadShutdown)
+            return;
+
+        auto itr = std::find_if(_preloadQueue.begin(), _preloadQueue.end(), [&](PreloadRequest const& request)
+        {
+            return request.MapId == terrain->GetId() && request.GridX == gx && request.GridY == gy;
+        });
+
+        if (itr != _preloadQueue.end())
+        {
+            // already queued, it only moves up if it got closer
+            if (itr->Distance <= distance)
+                return;
+
+            itr->Distance = distance;
+        }
+        else
+            _preloadQueue.push_back({ terrain, terrain->GetId(), gx, gy, distance, std::chrono::steady_clock::now() });
+
+        std::stable_sort(_preloadQueue.begin(), _preloadQueue.end(), [](PreloadRequest const& left, PreloadRequest const& right)
+        {
+            return left.Distance < right.Distance;
+        });
+
+        if (_preloadQueue.size() > _preloadQueueSize)
+        {
+            _preloadQueue.pop_back();
+            ++_droppedPreloads;
+        }
+    }
+
+    _preloadCondition.notify_one();
+}
+
+void TerrainMgr::PreloadThread()
+{
+    while (true)
+    {
+        PreloadRequest request;
+        {
+            std::unique_lock<std::mutex> lock(_preloadLock);
+            _preloadCondition.wait(lock, [this] { return _preloadShutdown || !_preloadQueue.empty(); });
+            if (_preloadShutdown)
+                return;
+
+            request = std::move(_preloadQueue.front());
+            _preloadQueue.erase(_preloadQueue.begin());
+        }
+
+        std::shared_ptr<TerrainInfo> terrain = request.Terrain.lock();
+        if (!terrain)
+            continue;
+
+        if (terrain->PrepareMapAndVMap(request.GridX, request.GridY, request.QueueTime))
+            TC_LOG_DEBUG("maps", "Preloaded grid [%d, %d] of map %u", request.GridX, request.GridY, request.MapId);
+
+        std::lock_guard<std::mutex> lock(_preloadLock);
+        _preloadReleasedTerrain.push_back(std::move(terrain));
+    }
+}
+
 uint32 TerrainMgr::GetAreaId(PhaseShift const& phaseShift, uint32 mapid, float x, float y, float z)
 {
     if (std::shared_ptr<TerrainInfo> t = LoadTerrain(mapid))
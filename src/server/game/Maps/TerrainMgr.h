@@ -26,8 +26,11 @@
 #include "Timer.h"
 #include <atomic>
 #include <bitset>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -58,11 +61,24 @@ public:
 
     void LoadMapAndVMap(int32 gx, int32 gy);
 
+    bool IsMapAndVMapLoaded(int32 gx, int32 gy) const { return _loadedGrids[GetBitsetIndex(gx, gy)]; }
+
+    // Reads the terrain, vmap models and mmap tile of a grid on a preload thread without changing anything the map reads.
+    // Returns false if the grid was already read. Time since queueTime is reported once the grid is published
+    bool PrepareMapAndVMap(int32 gx, int32 gy, std::chrono::steady_clock::time_point queueTime);
+    // Adds the grids read by preload threads, must be called by the thread updating the map owning this terrain.
+    // They stay loaded until the next cleanup unless the map starts using them
+    void PublishPreparedGrids();
+
 private:
-    void LoadMapAndVMapImpl(int32 gx, int32 gy);
-    void LoadMap(int32 gx, int32 gy);
+    struct PreparedGrid;
+
+    std::unique_ptr<PreparedGrid> ReadGrid(int32 gx, int32 gy) const;
+    std::unique_ptr<PreparedGrid> TakePreparedGrid(int32 gx, int32 gy);
+    void LoadMapAndVMapImpl(int32 gx, int32 gy, PreparedGrid* prepared = nullptr);
+    void LoadMap(int32 gx, int32 gy, PreparedGrid* prepared);
     void LoadVMap(int32 gx, int32 gy);
-    void LoadMMap(int32 gx, int32 gy);
+    void LoadMMap(int32 gx, int32 gy, PreparedGrid* prepared);
 
 public:
     void UnloadMap(int32 gx, int32 gy);
@@ -111,6 +127,10 @@ private:
     std::bitset<MAX_NUMBER_OF_GRIDS* MAX_NUMBER_OF_GRIDS> _loadedGrids;
     std::bitset<MAX_NUMBER_OF_GRIDS* MAX_NUMBER_OF_GRIDS> _gridFileExists; // cache what grids are available for this map (not including parent/child maps)
 
+    // grids read by preload threads, waiting for the map to publish them
+    std::vector<std::unique_ptr<PreparedGrid>> _preparedGrids;
+    std::mutex _preparedGridsLock;
+
     static constexpr Milliseconds CleanupInterval = 1min;
 
     // global garbage collection timer
@@ -150,11 +170,43 @@ public:
 
     static bool ExistMapAndVMap(uint32 mapid, float x, float y);
 
+    /// Starts the threads loading terrain grids in the background, 0 threads disables preloading
+    void StartPreloading(uint32 threads, uint32 queueSize);
+    void StopPreloading();
+    bool IsPreloadingEnabled() const { return !_preloadThreads.empty(); }
+
+    /// Queues a grid to be loaded in the background, grids closer to the player (lower distance) are loaded first.
+    /// Once the queue is full the farthest request is dropped.
+    void QueuePreload(std::shared_ptr<TerrainInfo> const& terrain, int32 gx, int32 gy, float distance);
+
 private:
     std::shared_ptr<TerrainInfo> LoadTerrainImpl(uint32 mapId);
 
+    struct PreloadRequest
+    {
+        std::weak_ptr<TerrainInfo> Terrain;
+        uint32 MapId;
+        int32 GridX;
+        int32 GridY;
+        float Distance;
+        std::chrono::steady_clock::time_point QueueTime;
+    };
+
+    void PreloadThread();
+
     std::unordered_map<uint32, std::weak_ptr<TerrainInfo>> _terrainMaps;
 
+    // pending preload requests ordered by ascending distance
+    std::vector<PreloadRequest> _preloadQueue;
+    std::size_t _preloadQueueSize;
+    std::mutex _preloadLock;
+    std::condition_variable _preloadCondition;
+    std::vector<std::thread> _preloadThreads;
+    // terrain references dropped by preload threads, released on the world thread so TerrainInfo is never destroyed by them
+    std::vector<std::shared_ptr<TerrainInfo>> _preloadReleasedTerrain;
+    bool _preloadShutdown;
+    std::atomic<uint32> _droppedPreloads;
+
     // parent map links
     std::unordered_map<uint32, std::vector<uint32>> _parentMapData;
 };
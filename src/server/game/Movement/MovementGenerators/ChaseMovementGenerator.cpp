@@ -20,9 +20,11 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "G3DPosition.hpp"
+#include "Map.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "PathGenerator.h"
+#include "PathRequestService.h"
 #include "Unit.h"
 #include "Util.h"
 #include "Vehicle.h"
@@ -83,6 +85,8 @@ void ChaseMovementGenerator::Initialize(Unit* owner)
     owner->AddUnitState(UNIT_STATE_CHASE);
     owner->SetWalk(false);
     _lastTargetPosition.reset();
+    _path.reset();
+    _pathRequest.reset();
     _nextMovementTimer.Reset(0);
     _nextRepositioningTimer.Reset(0);
 }
@@ -108,6 +112,7 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     {
         owner->StopMoving();
         _lastTargetPosition.reset();
+        _pathRequest.reset();
         if (Creature* cOwner = owner->ToCreature())
             cOwner->SetCannotReachTarget(false);
         return true;
@@ -146,6 +151,17 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     float const rangeTolerance      = _range > 0.f ? _range : chaseRange;
     Optional<ChaseAngle> chaseAngle = mutualChase ? Optional<ChaseAngle>() : _angle;
 
+    // The path requested during a previous update has been searched, it is repaired from where the owner moved since
+    if (_pathRequest && _pathRequest->Solved)
+    {
+        if (_path)
+            _path->SetPolyPath(*_pathRequest);
+
+        _pathRequest.reset();
+        LaunchMovement(owner, chaseRange, false, mutualChase);
+        return true;
+    }
+
     // Update Movement
     _nextMovementTimer.Update(diff);
     _nextRepositioningTimer.Update(diff);
@@ -186,7 +202,12 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
                 }
             }
             else if (owner->GetExactDist2d(target) > rangeTolerance + 0.1f) // 0.1f here to avoid edge cases when the owner has stepped back before
-                LaunchMovement(owner, chaseRange, false, mutualChase);
+            {
+                // a request still waiting since the last interval is not worth waiting for any longer
+                bool const allowPathRequest = !_pathRequest;
+                _pathRequest.reset();
+                LaunchMovement(owner, chaseRange, false, mutualChase, allowPathRequest);
+            }
         }
     }
 
@@ -195,12 +216,13 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
 
 void ChaseMovementGenerator::Finalize(Unit* owner)
 {
+    _pathRequest.reset();
     owner->ClearUnitState(UNIT_STATE_CHASE | UNIT_STATE_CHASE_MOVE);
     if (Creature* cOwner = owner->ToCreature())
         cOwner->SetCannotReachTarget(false);
 }
 
-void ChaseMovementGenerator::LaunchMovement(Unit* owner, float chaseRange, bool backward /*= false*/, bool mutualChase /*= false*/)
+void ChaseMovementGenerator::LaunchMovement(Unit* owner, float chaseRange, bool backward /*= false*/, bool mutualChase /*= false*/, bool allowPathRequest /*= false*/)
 {
     Unit* target = GetTarget();
 
@@ -239,9 +261,22 @@ void ChaseMovementGenerator::LaunchMovement(Unit* owner, float chaseRange, bool
     Creature* creature = owner->ToCreature();
     Movement::MoveSplineInit init(owner);
 
-    PathGenerator path(owner);
-    bool success = path.CalculatePath(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ(), owner->CanFly());
-    if (!success || (path.GetPathType() & (PATHFIND_NOPATH /*| PATHFIND_INCOMPLETE*/)))
+    if (!_path)
+        _path = std::make_unique<PathGenerator>(owner);
+
+    // Long paths are searched by the path request service, movement is launched once the request is solved
+    if (allowPathRequest && !backward && owner->GetExactDist2dSq(dest) > PATH_REQUEST_MIN_DISTANCE * PATH_REQUEST_MIN_DISTANCE)
+    {
+        if (std::shared_ptr<PathRequest> request = _path->CreatePathRequest(PositionToVector3(owner->GetPosition()), PositionToVector3(dest)))
+        {
+            _pathRequest = request;
+            owner->GetMap()->QueuePathRequest(std::move(request));
+            return;
+        }
+    }
+
+    bool success = _path->CalculatePath(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ(), owner->CanFly());
+    if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /*| PATHFIND_INCOMPLETE*/)))
     {
         if (creature)
             creature->SetCannotReachTarget(true);
@@ -250,7 +285,7 @@ void ChaseMovementGenerator::LaunchMovement(Unit* owner, float chaseRange, bool
         return;
     }
 
-    init.MovebyPath(path.GetPath());
+    init.MovebyPath(_path->GetPath());
     init.SetWalk(false);
     if (backward)
         init.SetBackward();
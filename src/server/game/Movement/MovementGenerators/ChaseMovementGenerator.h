@@ -22,8 +22,11 @@
 #include "AbstractPursuer.h"
 #include "Optional.h"
 #include "Timer.h"
+#include <memory>
 
+class PathGenerator;
 class Unit;
+struct PathRequest;
 
 class ChaseMovementGenerator : public MovementGenerator, public AbstractPursuer
 {
@@ -41,15 +44,18 @@ class ChaseMovementGenerator : public MovementGenerator, public AbstractPursuer
         void UnitSpeedChanged() override { _lastTargetPosition.reset(); }
 
     private:
-        void LaunchMovement(Unit* owner, float chaseRange, bool backward = false, bool mutualChase = false);
+        void LaunchMovement(Unit* owner, float chaseRange, bool backward = false, bool mutualChase = false, bool allowPathRequest = false);
 
         static constexpr uint32 CHASE_MOVEMENT_INTERVAL = 400; // sniffed value (1 batch update cyclice)
         static constexpr uint32 REPOSITION_MOVEMENT_INTERVAL = 1200; // (3 batch update cycles) TODO: verify
+        static constexpr float PATH_REQUEST_MIN_DISTANCE = 10.0f; // shorter paths are cheap enough to build right away
 
         TimeTrackerSmall _nextMovementTimer;
         TimeTrackerSmall _nextRepositioningTimer;
 
         Optional<Position> _lastTargetPosition;
+        std::unique_ptr<PathGenerator> _path;      // kept between launches so the previous poly path can be repaired
+        std::shared_ptr<PathRequest> _pathRequest; // searched off the map thread, movement launches once it is solved
         float const _range;
         Optional<ChaseAngle> const _angle;
 };
@@ -194,6 +194,7 @@ void FollowMovementGenerator::Finalize(Unit* owner)
 
 void FollowMovementGenerator::Reset(Unit* /*owner*/)
 {
+    _path.reset();
     _followMovementTimer.Reset(0);
     _events.ScheduleEvent(EVENT_ALLIGN_TO_TARGET, 1ms);
 }
@@ -354,8 +355,16 @@ void FollowMovementGenerator::LaunchMovement(Unit* owner)
         target->MovePositionToFirstCollision(dest, distance, relativeAngle);
     }
 
+    if (!_path)
+        _path = std::make_unique<PathGenerator>(owner);
+
     Movement::MoveSplineInit init(owner);
-    init.MoveTo(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ());
+    bool success = _path->CalculatePath(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ());
+    if (success && !(_path->GetPathType() & PATHFIND_NOPATH))
+        init.MovebyPath(_path->GetPath());
+    else
+        init.MoveTo(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ(), false);
+
     init.SetVelocity(velocity);
 
     if (_faceTarget)
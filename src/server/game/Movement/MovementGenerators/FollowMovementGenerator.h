@@ -23,7 +23,9 @@
 #include "EventMap.h"
 #include "Optional.h"
 #include "Timer.h"
+#include <memory>
 
+class PathGenerator;
 class Unit;
 
 enum Events
@@ -66,6 +68,7 @@ private:
 
     TimeTrackerSmall _followMovementTimer;
     EventMap _events;
+    std::unique_ptr<PathGenerator> _path; // kept between launches so the previous poly path can be repaired
 };
 
 #endif
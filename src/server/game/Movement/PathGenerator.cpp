@@ -27,27 +27,22 @@
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
 #include "Metric.h"
+#include "PathRequestService.h"
 #include "PhasingHandler.h"
+#include <algorithm>
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
-    _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
+    _endPosition(G3D::Vector3::zero()), _source(owner), _navMeshMapId(0), _navMesh(nullptr),
     _navMeshQuery(nullptr)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::PathGenerator for %u", _source->GetGUID().GetCounter());
 
-    uint32 mapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _source->GetPositionX(), _source->GetPositionY());
-    if (DisableMgr::IsPathfindingEnabled(mapId))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
-    }
-
+    UpdateNavMesh();
     CreateFilter();
 }
 
@@ -68,6 +63,11 @@ bool PathGenerator::CalculatePath(G3D::Vector3 const& startPoint, G3D::Vector3 c
 
     TC_METRIC_EVENT("mmap_events", "CalculatePath", "");
 
+    // the previous poly path is only repaired when the destination moved a little, a new search finds a better one otherwise
+    if (_polyLength && (_endPosition - endPoint).squaredLength() > CORRIDOR_REPAIR_MAX_DISTANCE * CORRIDOR_REPAIR_MAX_DISTANCE)
+        _polyLength = 0;
+
+    std::shared_lock<std::shared_mutex> tileLock = UpdateNavMesh();
     SetEndPosition(endPoint);
     SetStartPosition(startPoint);
 
@@ -81,6 +81,10 @@ bool PathGenerator::CalculatePath(G3D::Vector3 const& startPoint, G3D::Vector3 c
     if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
         !HaveTile(startPoint) || !HaveTile(endPoint))
     {
+        // heights of points off the nav mesh may load their grid, which adds tiles
+        if (tileLock)
+            tileLock.unlock();
+
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
         return true;
@@ -92,6 +96,79 @@ bool PathGenerator::CalculatePath(G3D::Vector3 const& startPoint, G3D::Vector3 c
     return true;
 }
 
+std::shared_ptr<PathRequest> PathGenerator::CreatePathRequest(G3D::Vector3 const& startPoint, G3D::Vector3 const& endPoint)
+{
+    if (!sPathRequestService.IsEnabled() || !_navMesh || !_navMeshQuery)
+        return nullptr;
+
+    if (!Trinity::IsValidMapCoord(startPoint.x, startPoint.y, startPoint.z) || !Trinity::IsValidMapCoord(endPoint.x, endPoint.y, endPoint.z))
+        return nullptr;
+
+    std::shared_lock<std::shared_mutex> tileLock = MMAP::MMapFactory::createOrGetMMapManager()->LockTiles(_navMeshMapId);
+    if (!tileLock)
+        return nullptr;
+
+    Unit const* sourceUnit = _source->ToUnit();
+    if ((sourceUnit && sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) || !HaveTile(startPoint) || !HaveTile(endPoint))
+        return nullptr;
+
+    UpdateFilter();
+
+    float const start[VERTEX_SIZE] = { startPoint.y, startPoint.z, startPoint.x };
+    float const end[VERTEX_SIZE] = { endPoint.y, endPoint.z, endPoint.x };
+    return std::make_shared<PathRequest>(_navMeshMapId, start, end, _filter.getIncludeFlags(), _filter.getExcludeFlags());
+}
+
+void PathGenerator::SetPolyPath(PathRequest const& request)
+{
+    // the poly refs are validated against the navmesh by the next UpdateNavMesh
+    if (request.MapId != _navMeshMapId || request.Path.empty() || request.Path.size() > MAX_PATH_LENGTH)
+        return;
+
+    std::copy(request.Path.begin(), request.Path.end(), _pathPolyRefs);
+    _polyLength = uint32(request.Path.size());
+    _startPosition = G3D::Vector3(request.Start[2], request.Start[0], request.Start[1]);
+    _endPosition = G3D::Vector3(request.End[2], request.End[0], request.End[1]);
+}
+
+std::shared_lock<std::shared_mutex> PathGenerator::UpdateNavMesh()
+{
+    // generators kept by movement generators may be used from another map update thread than before
+    // and navmesh queries are per thread, the terrain may also have been swapped since
+    uint32 mapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _source->GetPositionX(), _source->GetPositionY());
+    if (!DisableMgr::IsPathfindingEnabled(mapId))
+    {
+        _navMeshMapId = 0;
+        _navMesh = nullptr;
+        _navMeshQuery = nullptr;
+        _polyLength = 0;
+        return std::shared_lock<std::shared_mutex>();
+    }
+
+    // terrains of instances are shared by maps updated on other threads, which may add or remove tiles
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    std::shared_lock<std::shared_mutex> tileLock = mmap->LockTiles(mapId);
+    dtNavMesh const* navMesh = mmap->GetNavMesh(mapId);
+
+    // the salt of a poly ref changes when its tile is unloaded, the previous path is kept up to its first poly on such a tile
+    if (mapId != _navMeshMapId || !navMesh || navMesh != _navMesh)
+        _polyLength = 0;
+
+    for (uint32 i = 0; i < _polyLength; ++i)
+    {
+        if (!navMesh->isValidPolyRef(_pathPolyRefs[i]))
+        {
+            _polyLength = i;
+            break;
+        }
+    }
+
+    _navMeshMapId = mapId;
+    _navMesh = navMesh;
+    _navMeshQuery = mmap->GetNavMeshQuery(mapId);
+    return tileLock;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -296,6 +373,10 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     uint32 pathStartIndex = 0;
     uint32 pathEndIndex = 0;
 
+    // a mover that left its previous path (e.g. one solved by the path request service while it kept moving) is reconnected to it
+    if (_polyLength && !_useRaycast && std::find(_pathPolyRefs, _pathPolyRefs + _polyLength, startPoly) == _pathPolyRefs + _polyLength)
+        ReconnectPathStart(startPoly, startPoint);
+
     if (_polyLength)
     {
         for (; pathStartIndex < _polyLength; ++pathStartIndex)
@@ -336,6 +417,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         _polyLength = pathEndIndex - pathStartIndex + 1;
         memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
+        sPathRequestService.RecordCorridorRepair();
     }
     else if (startPolyFound && !endPolyFound)
     {
@@ -411,6 +493,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         // new path = prefix + suffix - overlap
         _polyLength = prefixPolyLength + suffixPolyLength - 1;
+        sPathRequestService.RecordCorridorRepair();
     }
     else
     {
@@ -493,6 +576,8 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 return;
             }
         }
+        else if (sPathRequestService.FindPolyPath(_navMesh, _navMeshMapId, startPoly, endPoly, _filter, _pathPolyRefs, &_polyLength, MAX_PATH_LENGTH))
+            dtResult = DT_SUCCESS;
         else
         {
             dtResult = _navMeshQuery->findPath(
@@ -504,6 +589,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                             _pathPolyRefs,     // [out] path
                             (int*)&_polyLength,
                             MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (dtStatusSucceed(dtResult))
+                sPathRequestService.StorePolyPath(_navMeshMapId, startPoly, endPoly, _filter, _pathPolyRefs, _polyLength);
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -731,6 +819,31 @@ bool PathGenerator::HaveTile(const G3D::Vector3& p) const
     return (_navMesh->getTileAt(tx, ty, 0) != nullptr);
 }
 
+void PathGenerator::ReconnectPathStart(dtPolyRef startPoly, float const* startPoint)
+{
+    float pathStart[VERTEX_SIZE];
+    if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(_pathPolyRefs[0], startPoint, pathStart, nullptr))
+        || dtVdistSqr(startPoint, pathStart) > CORRIDOR_REPAIR_MAX_DISTANCE * CORRIDOR_REPAIR_MAX_DISTANCE)
+    {
+        _polyLength = 0;
+        return;
+    }
+
+    dtPolyRef prefix[CORRIDOR_RECONNECT_MAX_LENGTH];
+    int32 prefixLength = 0;
+    dtStatus dtResult = _navMeshQuery->findPath(startPoly, _pathPolyRefs[0], startPoint, pathStart, &_filter, prefix, &prefixLength, CORRIDOR_RECONNECT_MAX_LENGTH);
+    if (dtStatusFailed(dtResult) || !prefixLength || prefix[prefixLength - 1] != _pathPolyRefs[0])
+    {
+        _polyLength = 0;
+        return;
+    }
+
+    // FixupCorridor takes the visited polys in the order they were walked, from the old path start to the mover
+    std::reverse(prefix, prefix + prefixLength);
+    _polyLength = FixupCorridor(_pathPolyRefs, _polyLength, MAX_PATH_LENGTH, prefix, uint32(prefixLength));
+    sPathRequestService.RecordCorridorRepair();
+}
+
 uint32 PathGenerator::FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
 {
     int32 furthestPath = -1;
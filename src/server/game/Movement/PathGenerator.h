@@ -23,9 +23,12 @@
 #include "MMapDefines.h"
 #include "MoveSplineInitArgs.h"
 #include <G3D/Vector3.h>
+#include <memory>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
+struct PathRequest;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -39,6 +42,11 @@ class WorldObject;
 #define VERTEX_SIZE       3
 #define INVALID_POLYREF   0
 
+// destination movement up to which the poly path of a reused generator is repaired instead of searched again
+#define CORRIDOR_REPAIR_MAX_DISTANCE 10.0f
+// longest search connecting a mover that left its previous poly path back to the start of it
+#define CORRIDOR_RECONNECT_MAX_LENGTH 16
+
 enum PathType
 {
     PATHFIND_BLANK             = 0x00,   // path not built yet
@@ -70,6 +78,11 @@ class TC_GAME_API PathGenerator
         // Calculates the path from start point to given destination
         bool CalculatePath(G3D::Vector3 const& startPoint, G3D::Vector3 const& endPoint, bool forceDest = false);
         bool IsInvalidDestinationZ(Unit const* target) const;
+        // Poly path search for the path request service, pass the solved request to SetPolyPath before the next CalculatePath
+        // return: nullptr when the path can not be searched asynchronously (no navmesh, missing tiles, service disabled)
+        std::shared_ptr<PathRequest> CreatePathRequest(G3D::Vector3 const& startPoint, G3D::Vector3 const& endPoint);
+        // Takes the poly path of a solved request as the previous path, the next CalculatePath repairs it from the current positions
+        void SetPolyPath(PathRequest const& request);
 
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
@@ -106,6 +119,7 @@ class TC_GAME_API PathGenerator
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         WorldObject const* const _source;       // the object that is moving
+        uint32 _navMeshMapId;                   // terrain map id of the nav mesh
         dtNavMesh const* _navMesh;              // the nav mesh
         dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
 
@@ -131,10 +145,13 @@ class TC_GAME_API PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        void ReconnectPathStart(dtPolyRef startPoly, float const* startPoint);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
         NavTerrainFlag GetNavTerrain(float x, float y, float z);
+        // the returned lock keeps tiles of the nav mesh from changing while it is searched, empty without a nav mesh
+        std::shared_lock<std::shared_mutex> UpdateNavMesh();
         void CreateFilter();
         void UpdateFilter();
 
@@ -0,0 +1,282 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathRequestService.h"
+#include "DetourNavMeshQuery.h"
+#include "Log.h"
+#include "Metric.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "PathGenerator.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+PathRequest::PathRequest(uint32 mapId, float const* start, float const* end, uint16 includeFlags, uint16 excludeFlags) :
+    MapId(mapId), IncludeFlags(includeFlags), ExcludeFlags(excludeFlags), Solved(false)
+{
+    memcpy(Start, start, sizeof(Start));
+    memcpy(End, end, sizeof(End));
+}
+
+std::size_t PathRequestService::CacheKeyHash::operator()(CacheKey const& key) const
+{
+    std::size_t hash = std::hash<dtPolyRef>()(key.StartRef);
+    hash ^= std::hash<dtPolyRef>()(key.EndRef) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint64>()((uint64(key.MapId) << 32) | (uint32(key.IncludeFlags) << 16) | key.ExcludeFlags) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+PathRequestService::PathRequestService() : _cacheSize(0), _shutdown(false), _solvedRequests(0), _cacheHits(0), _cacheMisses(0), _corridorRepairs(0) { }
+
+PathRequestService::~PathRequestService()
+{
+    Stop();
+}
+
+PathRequestService& PathRequestService::Instance()
+{
+    static PathRequestService instance;
+    return instance;
+}
+
+void PathRequestService::Start(uint32 threads, uint32 cacheSize)
+{
+    Stop();
+
+    if (!threads || !cacheSize)
+        return;
+
+    _cacheSize = cacheSize;
+    _cache.reserve(cacheSize + 1);
+    _shutdown = false;
+    for (uint32 i = 0; i < threads; ++i)
+        _threads.emplace_back(&PathRequestService::WorkerThread, this);
+}
+
+void PathRequestService::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _shutdown = true;
+        _queue.clear();
+    }
+
+    _queueCondition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+
+    _threads.clear();
+
+    std::lock_guard<std::mutex> lock(_cacheLock);
+    _cache.clear();
+    _cacheOrder.clear();
+}
+
+void PathRequestService::Submit(std::vector<std::shared_ptr<PathRequest>>&& batch)
+{
+    if (batch.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        if (!_shutdown)
+            std::move(batch.begin(), batch.end(), std::back_inserter(_queue));
+    }
+
+    batch.clear();
+    _queueCondition.notify_all();
+}
+
+void PathRequestService::CancelMap(uint32 mapId)
+{
+    if (!IsEnabled())
+        return;
+
+    std::unique_lock<std::mutex> lock(_queueLock);
+    _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [mapId](std::shared_ptr<PathRequest> const& request)
+    {
+        return request->MapId == mapId;
+    }), _queue.end());
+
+    _solvedCondition.wait(lock, [this, mapId] { return !_solvingCount[mapId]; });
+    lock.unlock();
+
+    // poly refs are only meaningful for the navmesh they were found on
+    std::lock_guard<std::mutex> cacheLock(_cacheLock);
+    _cacheOrder.erase(std::remove_if(_cacheOrder.begin(), _cacheOrder.end(), [this, mapId](CacheKey const& key)
+    {
+        if (key.MapId != mapId)
+            return false;
+
+        _cache.erase(key);
+        return true;
+    }), _cacheOrder.end());
+}
+
+bool PathRequestService::FindPolyPath(dtNavMesh const* navMesh, uint32 mapId, dtPolyRef startRef, dtPolyRef endRef, dtQueryFilter const& filter, dtPolyRef* path, uint32* pathLength, uint32 maxPathLength)
+{
+    if (!IsEnabled())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_cacheLock);
+    auto itr = _cache.find({ mapId, filter.getIncludeFlags(), filter.getExcludeFlags(), startRef, endRef });
+
+    // the salt of a poly ref changes when its tile is unloaded, paths over other tiles stay valid
+    if (itr == _cache.end() || itr->second.size() > maxPathLength || !std::all_of(itr->second.begin(), itr->second.end(), [navMesh](dtPolyRef polyRef)
+    {
+        return navMesh->isValidPolyRef(polyRef);
+    }))
+    {
+        ++_cacheMisses;
+        return false;
+    }
+
+    std::copy(itr->second.begin(), itr->second.end(), path);
+    *pathLength = uint32(itr->second.size());
+    ++_cacheHits;
+    return true;
+}
+
+void PathRequestService::StorePolyPath(uint32 mapId, dtPolyRef startRef, dtPolyRef endRef, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength)
+{
+    if (!IsEnabled() || !pathLength)
+        return;
+
+    CacheKey key{ mapId, filter.getIncludeFlags(), filter.getExcludeFlags(), startRef, endRef };
+
+    std::lock_guard<std::mutex> lock(_cacheLock);
+    auto result = _cache.emplace(key, std::vector<dtPolyRef>());
+    if (result.second)
+    {
+        _cacheOrder.push_back(key);
+        if (_cacheOrder.size() > _cacheSize)
+        {
+            _cache.erase(_cacheOrder.front());
+            _cacheOrder.pop_front();
+        }
+    }
+
+    result.first->second.assign(path, path + pathLength);
+}
+
+void PathRequestService::Update()
+{
+    TC_METRIC_VALUE("pathfinding_corridor_repairs", _corridorRepairs.exchange(0));
+
+    if (!IsEnabled())
+        return;
+
+    std::size_t queued;
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        queued = _queue.size();
+    }
+
+    TC_METRIC_VALUE("pathfinding_queue_size", uint32(queued));
+    TC_METRIC_VALUE("pathfinding_solved", _solvedRequests.exchange(0));
+    TC_METRIC_VALUE("pathfinding_cache_hits", _cacheHits.exchange(0));
+    TC_METRIC_VALUE("pathfinding_cache_misses", _cacheMisses.exchange(0));
+}
+
+void PathRequestService::WorkerThread()
+{
+    while (true)
+    {
+        std::shared_ptr<PathRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+            _queueCondition.wait(lock, [this] { return _shutdown || !_queue.empty(); });
+            if (_shutdown)
+                return;
+
+            request = std::move(_queue.front());
+            _queue.pop_front();
+            ++_solvingCount[request->MapId];
+        }
+
+        Solve(*request);
+        request->Solved = true;
+
+        {
+            std::lock_guard<std::mutex> lock(_queueLock);
+            --_solvingCount[request->MapId];
+        }
+
+        _solvedCondition.notify_all();
+    }
+}
+
+void PathRequestService::Solve(PathRequest& request)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    // tiles must not change while the query walks them
+    std::shared_lock<std::shared_mutex> tileLock = mmap->LockTiles(request.MapId);
+    if (!tileLock)
+        return;
+
+    dtNavMesh const* navMesh = mmap->GetNavMesh(request.MapId);
+    dtNavMeshQuery const* query = mmap->GetNavMeshQuery(request.MapId);
+    if (!navMesh || !query)
+        return;
+
+    dtQueryFilter filter;
+    filter.setIncludeFlags(request.IncludeFlags);
+    filter.setExcludeFlags(request.ExcludeFlags);
+
+    // same search boxes as PathGenerator::GetPolyByLocation
+    auto findPoly = [&](float const* point) -> dtPolyRef
+    {
+        float closestPoint[VERTEX_SIZE];
+        dtPolyRef polyRef = INVALID_POLYREF;
+        float extents[VERTEX_SIZE] = { 3.0f, 5.0f, 3.0f };
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, &filter, &polyRef, closestPoint)) && polyRef != INVALID_POLYREF)
+            return polyRef;
+
+        extents[1] = 50.0f;
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, &filter, &polyRef, closestPoint)))
+            return polyRef;
+
+        return INVALID_POLYREF;
+    };
+
+    dtPolyRef startRef = findPoly(request.Start);
+    dtPolyRef endRef = findPoly(request.End);
+    if (startRef == INVALID_POLYREF || endRef == INVALID_POLYREF || startRef == endRef)
+        return;
+
+    dtPolyRef path[MAX_PATH_LENGTH];
+    uint32 pathLength = 0;
+    if (FindPolyPath(navMesh, request.MapId, startRef, endRef, filter, path, &pathLength, MAX_PATH_LENGTH))
+    {
+        request.Path.assign(path, path + pathLength);
+        return;
+    }
+
+    int32 foundLength = 0;
+    if (dtStatusFailed(query->findPath(startRef, endRef, request.Start, request.End, &filter, path, &foundLength, MAX_PATH_LENGTH)) || foundLength <= 0)
+    {
+        TC_LOG_DEBUG("maps.mmaps", "PathRequestService: no path on map %u between polys " UI64FMTD " and " UI64FMTD, request.MapId, uint64(startRef), uint64(endRef));
+        return;
+    }
+
+    StorePolyPath(request.MapId, startRef, endRef, filter, path, uint32(foundLength));
+    request.Path.assign(path, path + foundLength);
+    ++_solvedRequests;
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PathRequestService_h__
+#define PathRequestService_h__
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class dtQueryFilter;
+
+/// Everything needed to search a poly path without touching the world, positions are in detour (y, z, x) order
+struct PathRequest
+{
+    PathRequest(uint32 mapId, float const* start, float const* end, uint16 includeFlags, uint16 excludeFlags);
+
+    uint32 MapId;
+    float Start[3];
+    float End[3];
+    uint16 IncludeFlags;
+    uint16 ExcludeFlags;
+    std::vector<dtPolyRef> Path;    // found poly path, written before Solved is set and empty if none was found
+    std::atomic<bool> Solved;
+};
+
+/**
+* Searches poly paths for requests collected during map updates on its own threads, every thread using its own
+* dtNavMeshQuery. The found path is handed back through the request, the requester repairs it from wherever it
+* moved since. Found paths are also kept in a cache by (start poly, end poly, filter) that PathGenerator consults
+* before searching itself.
+*/
+class TC_GAME_API PathRequestService
+{
+    PathRequestService();
+    ~PathRequestService();
+public:
+    PathRequestService(PathRequestService const&) = delete;
+    PathRequestService(PathRequestService&&) = delete;
+    PathRequestService& operator=(PathRequestService const&) = delete;
+    PathRequestService& operator=(PathRequestService&&) = delete;
+
+    static PathRequestService& Instance();
+
+    /// Starts the threads searching paths, 0 threads disables requests (paths are only built synchronously)
+    void Start(uint32 threads, uint32 cacheSize);
+    void Stop();
+    bool IsEnabled() const { return !_threads.empty(); }
+
+    /// Queues the requests of one map update, they are solved in order by the first free thread
+    void Submit(std::vector<std::shared_ptr<PathRequest>>&& batch);
+
+    /// Drops queued requests and cached paths of the map and waits for the ones being solved, must be called before its navmesh is unloaded
+    void CancelMap(uint32 mapId);
+
+    /// Copies a poly path found before between both polygons with the same filter, false if unknown or a tile it crosses was unloaded since
+    /// The caller must hold the tile lock of the navmesh
+    bool FindPolyPath(dtNavMesh const* navMesh, uint32 mapId, dtPolyRef startRef, dtPolyRef endRef, dtQueryFilter const& filter, dtPolyRef* path, uint32* pathLength, uint32 maxPathLength);
+    void StorePolyPath(uint32 mapId, dtPolyRef startRef, dtPolyRef endRef, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength);
+
+    /// Counts poly paths of reused PathGenerators that were cut or extended instead of searched again
+    void RecordCorridorRepair() { ++_corridorRepairs; }
+
+    void Update();
+
+private:
+    struct CacheKey
+    {
+        uint32 MapId;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+        dtPolyRef StartRef;
+        dtPolyRef EndRef;
+
+        bool operator==(CacheKey const& right) const
+        {
+            return MapId == right.MapId && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags
+                && StartRef == right.StartRef && EndRef == right.EndRef;
+        }
+    };
+
+    struct CacheKeyHash
+    {
+        std::size_t operator()(CacheKey const& key) const;
+    };
+
+    void WorkerThread();
+    void Solve(PathRequest& request);
+
+    // found paths, the oldest are evicted first once the cache is full
+    std::unordered_map<CacheKey, std::vector<dtPolyRef>, CacheKeyHash> _cache;
+    std::deque<CacheKey> _cacheOrder;
+    std::size_t _cacheSize;
+    std::mutex _cacheLock;
+
+    std::deque<std::shared_ptr<PathRequest>> _queue;
+    std::unordered_map<uint32, uint32> _solvingCount;  // requests being solved per map
+    std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    std::condition_variable _solvedCondition;
+    std::vector<std::thread> _threads;
+    bool _shutdown;
+
+    std::atomic<uint32> _solvedRequests;
+    std::atomic<uint32> _cacheHits;
+    std::atomic<uint32> _cacheMisses;
+    std::atomic<uint32> _corridorRepairs;
+};
+
+#define sPathRequestService PathRequestService::Instance()
+
+#endif // PathRequestService_h__
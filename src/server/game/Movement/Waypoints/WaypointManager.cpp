@@ -25,7 +25,7 @@ void WaypointMgr::Load()
     uint32 oldMSTime = getMSTime();
 
     //                                               0   1      2           3           4           5            6         7          8      9                 10      11
-    QueryResult result = WorldDatabase.Query("SELECT id, point, position_x, position_y, position_z, orientation, velocity, move_type, delay, smoothTransition, action, action_chance FROM waypoint_data ORDER BY id, point");
+    QueryResult result = WorldDatabase.StreamQuery("SELECT id, point, position_x, position_y, position_z, orientation, velocity, move_type, delay, smoothTransition, action, action_chance FROM waypoint_data ORDER BY id, point");
 
     if (!result)
     {
@@ -79,6 +79,12 @@ void WaypointMgr::Load()
     }
     while (result->NextRow());
 
+    if (result->HasError())
+    {
+        TC_LOG_FATAL("sql.sql", "Reading `waypoint_data` rows failed after %u waypoints, aborting.", count);
+        ABORT();
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded %u waypoints in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -17,6 +17,7 @@
 
 #include "PhaseShift.h"
 #include "Containers.h"
+#include <algorithm>
 
 bool PhaseShift::AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Condition*> const* areaConditions, int32 references /*= 1*/)
 {
@@ -145,6 +146,16 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
     return checkInversePhaseShift(other, *this);
 }
 
+bool PhaseShift::HasSameVisibility(PhaseShift const& other) const
+{
+    // CanSee only looks at flags, the personal owner and ids and flags of phases
+    return Flags.AsUnderlyingType() == other.Flags.AsUnderlyingType() && PersonalGuid == other.PersonalGuid
+        && std::equal(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(), [](PhaseRef const& left, PhaseRef const& right)
+    {
+        return left.Id == right.Id && left.Flags.AsUnderlyingType() == right.Flags.AsUnderlyingType();
+    });
+}
+
 void PhaseShift::ModifyPhasesReferences(PhaseContainer::iterator itr, int32 references)
 {
     itr->References += references;
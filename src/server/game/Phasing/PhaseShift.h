@@ -106,6 +106,8 @@ public:
     void ClearPhases();
 
     bool CanSee(PhaseShift const& other) const;
+    // Both phase shifts see (and are seen by) exactly the same objects
+    bool HasSameVisibility(PhaseShift const& other) const;
 
 protected:
     friend class PhasingHandler;
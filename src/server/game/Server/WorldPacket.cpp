@@ -22,7 +22,8 @@
 #include <zlib.h>
 
 //! Compresses packet in place
-void WorldPacket::Compress(z_stream* compressionStream)
+//! resetHistory makes the stream forget all data compressed before, required after data was sent to the client outside of it
+void WorldPacket::Compress(z_stream* compressionStream, bool resetHistory /*= false*/)
 {
     OpcodeServer uncompressedOpcode = OpcodeServer(GetOpcode());
     if (uncompressedOpcode & COMPRESSED_OPCODE_MASK)
@@ -33,12 +34,12 @@ void WorldPacket::Compress(z_stream* compressionStream)
 
     uint32 opcode = uncompressedOpcode | COMPRESSED_OPCODE_MASK;
     uint32 size = wpos();
-    uint32 destsize = compressBound(size);
+    uint32 destsize = compressBound(size) + (resetHistory ? 8 : 0);   // empty stored block emitted by the full flush
 
     std::vector<uint8> storage(destsize);
 
     _compressionStream = compressionStream;
-    Compress(static_cast<void*>(&storage[0]), &destsize, static_cast<const void*>(contents()), size);
+    Compress(static_cast<void*>(&storage[0]), &destsize, static_cast<const void*>(contents()), size, resetHistory);
     if (destsize == 0)
         return;
 
@@ -82,10 +83,25 @@ void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* sourc
     TC_LOG_INFO("network", "%s (len %u) successfully compressed to %04X (len %u)", GetOpcodeNameForLogging(uncompressedOpcode).c_str(), size, opcode, destsize);
 }
 
-void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src_size)
+void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src_size, bool resetHistory /*= false*/)
 {
     _compressionStream->next_out = (Bytef*)dst;
     _compressionStream->avail_out = *dst_size;
+
+    if (resetHistory)
+    {
+        _compressionStream->next_in = nullptr;
+        _compressionStream->avail_in = 0;
+
+        int32 z_res = deflate(_compressionStream, Z_FULL_FLUSH);
+        if (z_res != Z_OK)
+        {
+            TC_LOG_ERROR("network", "Can't reset packet compression history (zlib: deflate) Error code: %i (%s, msg: %s)", z_res, zError(z_res), _compressionStream->msg);
+            *dst_size = 0;
+            return;
+        }
+    }
+
     _compressionStream->next_in = (Bytef*)src;
     _compressionStream->avail_in = (uInt)src_size;
 
@@ -106,3 +122,28 @@ void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src
 
     *dst_size -= _compressionStream->avail_out;
 }
+
+WorldPacket const* SharedWorldPacket::GetCompressed() const
+{
+    std::call_once(_compressOnce, [this]()
+    {
+        // raw deflate without zlib header and without any history - the block can be spliced into every
+        // connection's stream after its own Z_SYNC_FLUSH output, the next packet compressed by that stream must reset its history
+        z_stream stream = { };
+        int32 z_res = deflateInit2(&stream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        if (z_res != Z_OK)
+        {
+            TC_LOG_ERROR("network", "Can't initialize shared packet compression (zlib: deflateInit2) Error code: %i (%s)", z_res, zError(z_res));
+            return;
+        }
+
+        std::unique_ptr<WorldPacket> compressed = std::make_unique<WorldPacket>();
+        compressed->Compress(&stream, &_packet);
+        deflateEnd(&stream);
+
+        if (compressed->GetOpcode() == (_packet.GetOpcode() | COMPRESSED_OPCODE_MASK))
+            _compressed = std::move(compressed);
+    });
+
+    return _compressed.get();
+}
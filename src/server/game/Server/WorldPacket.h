@@ -22,6 +22,8 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 #include <chrono>
+#include <memory>
+#include <mutex>
 
 struct z_stream_s;
 
@@ -87,7 +89,7 @@ class WorldPacket : public ByteBuffer
         uint16 GetOpcode() const { return m_opcode; }
         void SetOpcode(uint16 opcode) { m_opcode = opcode; }
         bool IsCompressed() const { return (m_opcode & COMPRESSED_OPCODE_MASK) != 0; }
-        void Compress(z_stream_s* compressionStream);
+        void Compress(z_stream_s* compressionStream, bool resetHistory = false);
         void Compress(z_stream_s* compressionStream, WorldPacket const* source);
 
         ConnectionType GetConnection() const { return _connection; }
@@ -97,9 +99,31 @@ class WorldPacket : public ByteBuffer
     protected:
         uint16 m_opcode;
         ConnectionType _connection;
-        void Compress(void* dst, uint32 *dst_size, const void* src, int src_size);
+        void Compress(void* dst, uint32 *dst_size, const void* src, int src_size, bool resetHistory = false);
         z_stream_s* _compressionStream;
         std::chrono::steady_clock::time_point m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
+/// Immutable packet that is queued into many sockets without being copied for each of them.
+/// Its compressed form is a self-contained deflate block built only once and usable on any connection.
+class TC_GAME_API SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& packet) : _packet(packet) { }
+        explicit SharedWorldPacket(WorldPacket&& packet) : _packet(std::move(packet)) { }
+
+        SharedWorldPacket(SharedWorldPacket const&) = delete;
+        SharedWorldPacket& operator=(SharedWorldPacket const&) = delete;
+
+        WorldPacket const& GetPacket() const { return _packet; }
+
+        /// Compresses the packet on first call; nullptr if compression failed
+        WorldPacket const* GetCompressed() const;
+
+    private:
+        WorldPacket _packet;
+        mutable std::once_flag _compressOnce;
+        mutable std::unique_ptr<WorldPacket> _compressed;
+};
+
 #endif
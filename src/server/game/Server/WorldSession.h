@@ -43,6 +43,7 @@ class LoginQueryHolder;
 class Object;
 class Player;
 class Quest;
+class SharedWorldPacket;
 class SpellCastTargets;
 class Unit;
 class Warden;
@@ -476,6 +477,7 @@ class TC_GAME_API WorldSession
         void SendAddonsInfo();
         bool IsAddonRegistered(const std::string& prefix) const;
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(std::shared_ptr<SharedWorldPacket const> const& packet);
         void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[1] = sock; }
 
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
@@ -1334,6 +1336,9 @@ class TC_GAME_API WorldSession
 
         bool CanUseBank(ObjectGuid bankerGUID = ObjectGuid::Empty) const;
 
+        // validates an outgoing packet and selects the connection it is sent on
+        bool PrepareSendPacket(WorldPacket const* packet, bool forced, ConnectionType& conIdx);
+
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
 
@@ -31,7 +31,9 @@
 #include "Realm.h"
 #include "ScriptMgr.h"
 #include "SHA1.h"
+#include "ThreadPool.h"
 #include "World.h"
+#include "WorldSocketMgr.h"
 #include <zlib.h>
 #include <memory>
 
@@ -42,7 +44,7 @@ std::string const WorldSocket::ClientConnectionInitialize("WORLD OF WARCRAFT CON
 
 WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
     _type(CONNECTION_TYPE_REALM), _authSeed(rand32()), _OverSpeedPings(0), _worldSession(nullptr),
-    _authed(false), _compressionStream(nullptr), _sendBufferSize(4096),
+    _authed(false), _compressionStream(nullptr), _compressionHistoryReset(false), _sendBufferSize(4096), _compressionInProgress(false),
     _initialized(false)
 {
     _headerBuffer.Resize(2);
@@ -50,6 +52,9 @@ WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
 
 WorldSocket::~WorldSocket()
 {
+    for (EncryptablePacket* packet : _compressedPackets)
+        delete packet;
+
     if (_compressionStream)
     {
         deflateEnd(_compressionStream);
@@ -101,49 +106,129 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 
 bool WorldSocket::Update()
 {
-    EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
-    while (_bufferQueue.Dequeue(queued))
+    // packets must leave in the order they were queued - nothing new is sent while a batch is still being compressed
+    if (!_compressionInProgress.load(std::memory_order_acquire))
     {
-        if (queued->size() > 0x400 && !queued->IsCompressed())
-            queued->Compress(_compressionStream);
+        MessageBuffer buffer(_sendBufferSize);
+        for (EncryptablePacket* compressed : _compressedPackets)
+        {
+            WritePacketToBuffer(*compressed, buffer);
+            delete compressed;
+        }
 
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
-        if (queued->NeedsEncryption())
-            _authCrypt.EncryptSend(header.header, header.getHeaderLength());
+        _compressedPackets.clear();
 
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        std::vector<EncryptablePacket*> pending;
+        EncryptablePacket* queued;
+        while (_bufferQueue.Dequeue(queued))
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
+            if (pending.empty() && !queued->NeedsCompression())
+            {
+                WritePacketToBuffer(*queued, buffer);
+                delete queued;
+                continue;
+            }
+
+            // everything after the first packet that needs compression waits for it
+            pending.push_back(queued);
         }
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+        if (!pending.empty() && !QueueForCompression(pending))
         {
-            buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                buffer.Write(queued->contents(), queued->size());
+            for (EncryptablePacket* packet : pending)
+            {
+                CompressPacket(*packet);
+
+                WritePacketToBuffer(*packet, buffer);
+                delete packet;
+            }
         }
-        else    // single packet larger than 4096 bytes
-        {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
-            packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
 
-            QueuePacket(std::move(packetBuffer));
+        if (buffer.GetActiveSize() > 0)
+            QueuePacket(std::move(buffer));
+    }
+
+    if (!BaseSocket::Update())
+        return false;
+
+    _queryProcessor.ProcessReadyCallbacks();
+
+    return true;
+}
+
+void WorldSocket::CompressPacket(EncryptablePacket& packet)
+{
+    if (!packet.NeedsCompression())
+        return;
+
+    if (SharedWorldPacket const* shared = packet.GetSharedPacket())
+    {
+        // the shared block has no zlib stream header, so it can only follow data that already went through our own stream
+        if (_compressionStream->total_out > 0)
+        {
+            if (WorldPacket const* compressed = shared->GetCompressed())
+            {
+                packet.UseSharedCompressedPayload(compressed);
+                _compressionHistoryReset = true;
+                return;
+            }
         }
 
-        delete queued;
+        packet.DetachSharedPacket();
     }
 
-    if (buffer.GetActiveSize() > 0)
+    packet.Compress(_compressionStream, _compressionHistoryReset);
+    _compressionHistoryReset = false;
+}
+
+void WorldSocket::WritePacketToBuffer(EncryptablePacket const& queued, MessageBuffer& buffer)
+{
+    WorldPacket const& packet = queued.GetPayload();
+    CountQueuedPackets(1);
+    ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
+    if (queued.NeedsEncryption())
+        _authCrypt.EncryptSend(header.header, header.getHeaderLength());
+
+    if (buffer.GetRemainingSpace() < packet.size() + header.getHeaderLength())
+    {
         QueuePacket(std::move(buffer));
+        buffer.Resize(_sendBufferSize);
+    }
 
-    if (!BaseSocket::Update())
+    if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
+    {
+        buffer.Write(header.header, header.getHeaderLength());
+        if (!packet.empty())
+            buffer.Write(packet.contents(), packet.size());
+    }
+    else    // single packet larger than 4096 bytes
+    {
+        MessageBuffer packetBuffer(packet.size() + header.getHeaderLength());
+        packetBuffer.Write(header.header, header.getHeaderLength());
+        if (!packet.empty())
+            packetBuffer.Write(packet.contents(), packet.size());
+
+        QueuePacket(std::move(packetBuffer));
+    }
+}
+
+bool WorldSocket::QueueForCompression(std::vector<EncryptablePacket*>& packets)
+{
+    Trinity::ThreadPool* pool = sWorldSocketMgr.GetCompressionPool();
+    if (!pool)
         return false;
 
-    _queryProcessor.ProcessReadyCallbacks();
+    // the deflate stream is shared by all packets of this connection so the whole batch
+    // is compressed by a single job, in order; encryption of the headers stays on this thread
+    _compressedPackets.swap(packets);
+    _compressionInProgress.store(true, std::memory_order_relaxed);
+    pool->PostWork([self = shared_from_this()]()
+    {
+        for (EncryptablePacket* packet : self->_compressedPackets)
+            self->CompressPacket(*packet);
+
+        self->_compressionInProgress.store(false, std::memory_order_release);
+    });
 
     return true;
 }
@@ -170,6 +255,12 @@ void WorldSocket::OnClose()
     }
 }
 
+bool WorldSocket::HasPendingWrites() const
+{
+    // a batch being compressed must not be cut off by a delayed close
+    return _compressionInProgress.load(std::memory_order_acquire) || !_compressedPackets.empty() || !_bufferQueue.Empty();
+}
+
 void WorldSocket::ReadHandler()
 {
     if (!IsOpen())
@@ -524,6 +615,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<SharedWorldPacket const> packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(packet->GetPacket(), SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession)
 {
     // Get the account information from the auth database
@@ -35,17 +35,41 @@ using boost::asio::ip::tcp;
 class EncryptablePacket : public WorldPacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt), _sharedPayload(nullptr)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    EncryptablePacket(std::shared_ptr<SharedWorldPacket const> packet, bool encrypt) : WorldPacket(), _encrypt(encrypt),
+        _shared(std::move(packet)), _sharedPayload(&_shared->GetPacket())
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
     bool NeedsEncryption() const { return _encrypt; }
+    bool NeedsCompression() const { return GetPayload().size() > 0x400 && !GetPayload().IsCompressed(); }
+
+    SharedWorldPacket const* GetSharedPacket() const { return _shared.get(); }
+
+    /// packet that is written to the socket - this one or the shared packet it references
+    WorldPacket const& GetPayload() const { return _sharedPayload ? *_sharedPayload : *this; }
+
+    void UseSharedCompressedPayload(WorldPacket const* compressed) { _sharedPayload = compressed; }
+
+    /// copies the shared packet into this one to compress it with the socket's own stream
+    void DetachSharedPacket()
+    {
+        WorldPacket::operator=(_shared->GetPacket());
+        _sharedPayload = nullptr;
+        _shared.reset();
+    }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
     bool _encrypt;
+    std::shared_ptr<SharedWorldPacket const> _shared;
+    WorldPacket const* _sharedPayload;
 };
 
 struct z_stream_s;
@@ -95,6 +119,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<SharedWorldPacket const> packet);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
     ConnectionType GetConnectionType() const { return _type; }
@@ -104,6 +129,7 @@ public:
 
 protected:
     void OnClose() override;
+    bool HasPendingWrites() const override;
     void ReadHandler() override;
     bool ReadHeaderHandler();
 
@@ -124,6 +150,12 @@ private:
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
+    /// writes (and encrypts) header and payload of a packet into the send buffer, flushing it to the write queue when full
+    void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    /// compresses the packet with the socket's stream, or selects the shared compressed form of a broadcast
+    void CompressPacket(EncryptablePacket& packet);
+    /// hands packets that need compression to the compression pool, returns false if they have to be sent without waiting for it
+    bool QueueForCompression(std::vector<EncryptablePacket*>& packets);
     void HandleSendAuthSession();
     void HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession);
     void HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession, PreparedQueryResult result);
@@ -151,9 +183,12 @@ private:
     MessageBuffer _packetBuffer;
 
     z_stream_s* _compressionStream;
+    bool _compressionHistoryReset;                          // next packet compressed by _compressionStream must not refer to earlier data
 
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
+    std::vector<EncryptablePacket*> _compressedPackets;     // owned by compression pool while _compressionInProgress is set
+    std::atomic<bool> _compressionInProgress;
 
     bool _initialized;
 
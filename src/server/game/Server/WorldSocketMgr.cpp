@@ -18,6 +18,7 @@
 #include "Config.h"
 #include "NetworkThread.h"
 #include "ScriptMgr.h"
+#include "ThreadPool.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
 #include "World.h"
@@ -35,6 +36,7 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetWriteGatherLimit(sWorldSocketMgr.GetWriteGatherLimit());
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -44,7 +46,7 @@ public:
     }
 };
 
-WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true), _writeGatherLimit(16)
 {
 }
 
@@ -77,6 +79,12 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
         return false;
     }
 
+    _writeGatherLimit = std::max(sConfigMgr->GetIntDefault("Network.WriteGatherBuffers", 16), 1);
+
+    int32 compressionThreads = sConfigMgr->GetIntDefault("Network.CompressionThreads", 0);
+    if (compressionThreads > 0)
+        _compressionPool = std::make_unique<Trinity::ThreadPool>(compressionThreads);
+
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
@@ -116,6 +124,13 @@ void WorldSocketMgr::StopNetwork()
 
     BaseSocketMgr::StopNetwork();
 
+    // sockets with a batch still being compressed are kept alive by the pending work
+    if (_compressionPool)
+    {
+        _compressionPool->Join();
+        _compressionPool.reset();
+    }
+
     delete _instanceAcceptor;
     _instanceAcceptor = nullptr;
 
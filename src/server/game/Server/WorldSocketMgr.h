@@ -25,9 +25,15 @@
 #define __WORLDSOCKETMGR_H
 
 #include "SocketMgr.h"
+#include <memory>
 
 class WorldSocket;
 
+namespace Trinity
+{
+    class ThreadPool;
+}
+
 /// Manages all sockets connected to peers and network threads
 class TC_GAME_API WorldSocketMgr : public SocketMgr<WorldSocket>
 {
@@ -48,6 +54,11 @@ public:
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
 
+    std::size_t GetWriteGatherLimit() const { return _writeGatherLimit; }
+
+    /// Worker pool that compresses large outgoing packets off the network threads, null when disabled
+    Trinity::ThreadPool* GetCompressionPool() const { return _compressionPool.get(); }
+
 protected:
     WorldSocketMgr();
 
@@ -58,6 +69,8 @@ private:
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
     bool _tcpNoDelay;
+    std::size_t _writeGatherLimit;
+    std::unique_ptr<Trinity::ThreadPool> _compressionPool;
 };
 
 #define sWorldSocketMgr WorldSocketMgr::Instance()
@@ -1421,6 +1421,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
         if (uint32 maxTargets = m_spellValue->MaxAffectedTargets)
             Trinity::Containers::RandomResize(targets, maxTargets);
 
+        PrepareAreaTargetsLineOfSight(targets, center);
+
         for (WorldObject* itr : targets)
         {
             if (Unit* unit = itr->ToUnit())
@@ -1430,7 +1432,43 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             else if (Corpse* corpse = itr->ToCorpse())
                 AddCorpseTarget(corpse, effMask);
         }
+
+        m_areaTargetsLineOfSight.clear();
+    }
+}
+
+void Spell::PrepareAreaTargetsLineOfSight(std::list<WorldObject*> const& targets, Position const* losPosition)
+{
+    m_areaTargetsLineOfSight.clear();
+    if (!losPosition || m_spellInfo->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, nullptr, SPELL_DISABLE_LOS))
+        return;
+
+    // every target is checked against the center once and together instead of once per target and effect in CheckEffectTarget
+    std::vector<Unit const*> units;
+    std::vector<PhaseShift const*> phaseShifts;
+    std::vector<G3D::Vector3> starts;
+    std::vector<G3D::Vector3> ends;
+    for (WorldObject const* target : targets)
+    {
+        Unit const* unit = target->ToUnit();
+        if (!unit || !unit->IsInWorld() || unit->GetMap() != m_caster->GetMap())
+            continue;
+
+        Position start, end;
+        unit->GetLineOfSightSegment(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), start, end);
+        units.push_back(unit);
+        phaseShifts.push_back(&unit->GetPhaseShift());
+        starts.push_back(PositionToVector3(start));
+        ends.push_back(PositionToVector3(end));
     }
+
+    if (units.size() < 2)
+        return;
+
+    std::vector<bool> visible(units.size(), true);
+    m_caster->GetMap()->isInLineOfSight(phaseShifts.data(), starts.data(), ends.data(), units.size(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2, visible);
+    for (std::size_t i = 0; i < units.size(); ++i)
+        m_areaTargetsLineOfSight[units[i]->GetGUID()] = visible[i];
 }
 
 void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
@@ -7773,8 +7811,11 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* lo
             }
 
             if (losPosition)
-                if (!target->IsWithinLOS(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2))
+            {
+                auto itr = m_areaTargetsLineOfSight.find(target->GetGUID());
+                if (itr != m_areaTargetsLineOfSight.end() ? !itr->second : !target->IsWithinLOS(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2))
                     return false;
+            }
             break;
         }
     }
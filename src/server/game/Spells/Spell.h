@@ -26,6 +26,7 @@
 #include "SharedDefines.h"
 #include <any>
 #include <memory>
+#include <unordered_map>
 
 namespace WorldPackets
 {
@@ -490,6 +491,7 @@ class TC_GAME_API Spell
         void DoCreateItem(uint32 i, uint32 itemtype);
 
         bool CheckEffectTarget(Unit const* target, uint32 eff, Position const* losPosition) const;
+        void PrepareAreaTargetsLineOfSight(std::list<WorldObject*> const& targets, Position const* losPosition);
         bool CanAutoCast(Unit* target);
         void CheckSrc();
         void CheckDst();
@@ -706,6 +708,7 @@ class TC_GAME_API Spell
         };
         std::vector<TargetInfo> m_UniqueTargetInfo;
         uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
+        std::unordered_map<ObjectGuid, bool> m_areaTargetsLineOfSight; // line of sight of the area targets being added towards their center
 
         struct GOTargetInfo : public TargetInfoBase
         {
@@ -66,6 +66,7 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
+#include "PathRequestService.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
@@ -79,6 +80,7 @@
 #include "SkillExtraItems.h"
 #include "SmartScriptMgr.h"
 #include "SpellMgr.h"
+#include "TaskGraph.h"
 #include "TerrainMgr.h"
 #include "TicketMgr.h"
 #include "TransportMgr.h"
@@ -96,6 +98,7 @@
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/algorithm/string.hpp>
+#include <numeric>
 
 TC_GAME_API std::atomic<bool> World::m_stopEvent(false);
 TC_GAME_API uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -753,6 +756,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = sConfigMgr->GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
+    m_bool_configs[CONFIG_PLAYER_SAVE_SKIP_UNCHANGED] = sConfigMgr->GetBoolDefault("PlayerSave.SkipUnchanged", true);
 
     m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = sConfigMgr->GetIntDefault("PlayerSave.Stats.MinLevel", 0);
     if (m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] > MAX_LEVEL)
@@ -1469,6 +1473,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
+    m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED] = sConfigMgr->GetBoolDefault("MapFiles.MemoryMapped", true);
+
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", 0);
     bool enableIndoor = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", true);
     bool enableLOS = sConfigMgr->GetBoolDefault("vmap.enableLOS", true);
@@ -1479,6 +1485,7 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapManager()->SetMemoryMappedFiles(m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED]);
     TC_LOG_INFO("server.loading", "VMap support included. LineOfSight: %i, getHeight: %i, indoorCheck: %i", enableLOS, enableHeight, enableIndoor);
     TC_LOG_INFO("server.loading", "VMap data directory is: %svmaps", m_dataPath.c_str());
 
@@ -1502,6 +1509,15 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MAP_ISLAND_UPDATE_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.Islands.Threads", 0);
+    m_int_configs[CONFIG_TERRAIN_PRELOAD_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.Preload.Threads", 1);
+    m_int_configs[CONFIG_TERRAIN_PRELOAD_QUEUE_SIZE] = sConfigMgr->GetIntDefault("MapUpdate.Preload.QueueSize", 64);
+    m_int_configs[CONFIG_TERRAIN_PRELOAD_DISTANCE] = sConfigMgr->GetIntDefault("MapUpdate.Preload.Distance", 800);
+    m_int_configs[CONFIG_PATHFINDING_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.Pathfinding.Threads", 1);
+    m_int_configs[CONFIG_PATHFINDING_CACHE_SIZE] = sConfigMgr->GetIntDefault("MapUpdate.Pathfinding.CacheSize", 4096);
+    m_bool_configs[CONFIG_MAP_QUERY_CACHE] = sConfigMgr->GetBoolDefault("MapUpdate.QueryCache.Enable", true);
+    m_int_configs[CONFIG_STARTUP_THREADS] = sConfigMgr->GetIntDefault("Startup.Threads", 4);
+    m_bool_configs[CONFIG_WORLD_DATA_SNAPSHOT] = sConfigMgr->GetBoolDefault("WorldDataSnapshot.Enable", false);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1707,7 +1723,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC/DB2 files
     TC_LOG_INFO("server.loading", "Initialize data stores...");
-    sDBCManager.LoadStores(m_dataPath, m_defaultDbcLocale);
+    sDBCManager.LoadStores(m_dataPath, m_defaultDbcLocale, getIntConfig(CONFIG_STARTUP_THREADS));
     m_availableDbcLocaleMask = sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale);
     if (!(m_availableDbcLocaleMask & (1 << m_defaultDbcLocale)))
     {
@@ -1736,127 +1752,175 @@ void World::SetInitialWorldSettings()
     }
 
     sTerrainMgr.InitializeParentMapData(mapData);
+    sTerrainMgr.StartPreloading(getIntConfig(CONFIG_TERRAIN_PRELOAD_THREADS), getIntConfig(CONFIG_TERRAIN_PRELOAD_QUEUE_SIZE));
 
     vmmgr2->InitializeThreadUnsafe(mapData);
 
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapData);
 
+    sPathRequestService.Start(getIntConfig(CONFIG_PATHFINDING_THREADS), getIntConfig(CONFIG_PATHFINDING_CACHE_SIZE));
+
     TC_LOG_INFO("server.loading", "Initializing PlayerDump tables...");
     PlayerDump::InitializeTables();
 
     ///- Initialize static helper structures
     AIRegistry::Initialize();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo store...");
-    sSpellMgr->LoadSpellInfoStore();
+    if (getBoolConfig(CONFIG_WORLD_DATA_SNAPSHOT))
+    {
+        TC_LOG_INFO("server.loading", "Loading world data snapshot...");
+        sObjectMgr->LoadWorldDataSnapshot(sConfigMgr->GetStringDefault("WorldDataSnapshot.File", "world_data.snapshot"));
+    }
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo corrections...");
-    sSpellMgr->LoadSpellInfoCorrections();
+    ///- Loaders that only depend on data stores and on each other run concurrently, ordered by the prerequisites they declare
+    Trinity::TaskGraph startupTasks;
 
-    TC_LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data...");
-    sSpellMgr->LoadSkillLineAbilityMap();
+    Trinity::TaskGraph::TaskId spellInfoTask = startupTasks.AddTask("SpellInfo store", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading SpellInfo store...");
+        sSpellMgr->LoadSpellInfoStore();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo custom attributes...");
-    sSpellMgr->LoadSpellInfoCustomAttributes();
+        TC_LOG_INFO("server.loading", "Loading SpellInfo corrections...");
+        sSpellMgr->LoadSpellInfoCorrections();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo diminishing infos...");
-    sSpellMgr->LoadSpellInfoDiminishing();
+        TC_LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data...");
+        sSpellMgr->LoadSkillLineAbilityMap();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo immunity infos...");
-    sSpellMgr->LoadSpellInfoImmunities();
+        TC_LOG_INFO("server.loading", "Loading SpellInfo custom attributes...");
+        sSpellMgr->LoadSpellInfoCustomAttributes();
 
-    TC_LOG_INFO("server.loading", "Loading GameObject models...");
-    LoadGameObjectModelList(m_dataPath);
+        TC_LOG_INFO("server.loading", "Loading SpellInfo diminishing infos...");
+        sSpellMgr->LoadSpellInfoDiminishing();
 
-    TC_LOG_INFO("server.loading", "Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
+        TC_LOG_INFO("server.loading", "Loading SpellInfo immunity infos...");
+        sSpellMgr->LoadSpellInfoImmunities();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Instance Template...");
-    sObjectMgr->LoadInstanceTemplate();
+    startupTasks.AddTask("GameObject models", [this]()
+    {
+        TC_LOG_INFO("server.loading", "Loading GameObject models...");
+        LoadGameObjectModelList(m_dataPath);
+    });
 
-    // Must be called before `respawn` data
-    TC_LOG_INFO("server.loading", "Loading instances...");
-    sInstanceSaveMgr->LoadInstances();
+    Trinity::TaskGraph::TaskId scriptNamesTask = startupTasks.AddTask("Script names", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Script Names...");
+        sObjectMgr->LoadScriptNames();
+    });
 
-    // Load before guilds and arena teams
-    TC_LOG_INFO("server.loading", "Loading character cache store...");
-    sCharacterCache->LoadCharacterCacheStorage();
+    Trinity::TaskGraph::TaskId instancesTask = startupTasks.AddTask("Instances", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Instance Template...");
+        sObjectMgr->LoadInstanceTemplate();
 
-    TC_LOG_INFO("server.loading", "Loading Broadcast texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
+        // Must be called before `respawn` data
+        TC_LOG_INFO("server.loading", "Loading instances...");
+        sInstanceSaveMgr->LoadInstances();
+    }, { scriptNamesTask });
 
-    TC_LOG_INFO("server.loading", "Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-    sObjectMgr->LoadQuestGreetingsLocales();
+    // Load before guilds and arena teams, after instances cleaned up the characters table
+    startupTasks.AddTask("Character cache", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading character cache store...");
+        sCharacterCache->LoadCharacterCacheStorage();
+    }, { instancesTask });
 
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    Trinity::TaskGraph::TaskId localesTask = startupTasks.AddTask("Localization strings", [this]()
+    {
+        TC_LOG_INFO("server.loading", "Loading Broadcast texts...");
+        sObjectMgr->LoadBroadcastTexts();
+        sObjectMgr->LoadBroadcastTextLocales();
 
-    TC_LOG_INFO("server.loading", "Loading Account Roles and Permissions...");
-    sAccountMgr->LoadRBAC();
+        TC_LOG_INFO("server.loading", "Loading Localization strings...");
+        uint32 oldMSTime = getMSTime();
+        sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->LoadQuestLocales();
+        sObjectMgr->LoadNpcTextLocales();
+        sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->LoadGossipMenuItemsLocales();
+        sObjectMgr->LoadPointOfInterestLocales();
+        sObjectMgr->LoadQuestGreetingsLocales();
 
-    TC_LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+        sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
+        TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    startupTasks.AddTask("Account roles and permissions", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Account Roles and Permissions...");
+        sAccountMgr->LoadRBAC();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    Trinity::TaskGraph::TaskId pageTextsTask = startupTasks.AddTask("Page texts", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    startupTasks.AddTask("Game object templates and transports", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
 
-    TC_LOG_INFO("server.loading", "Loading Transport animations and rotations...");
-    sTransportMgr->LoadTransportAnimationAndRotation();
+        TC_LOG_INFO("server.loading", "Loading Game Object template addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
 
-    TC_LOG_INFO("server.loading", "Loading Transport spawns...");
-    sTransportMgr->LoadTransportSpawns();
+        TC_LOG_INFO("server.loading", "Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+
+        TC_LOG_INFO("server.loading", "Loading Transport animations and rotations...");
+        sTransportMgr->LoadTransportAnimationAndRotation();
+
+        TC_LOG_INFO("server.loading", "Loading Transport spawns...");
+        sTransportMgr->LoadTransportSpawns();
+    }, { pageTextsTask, scriptNamesTask, spellInfoTask });
+
+    startupTasks.AddTask("Spell data", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
+        sSpellMgr->LoadSpellRanks();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
+        TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+        TC_LOG_INFO("server.loading", "Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+        TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+        TC_LOG_INFO("server.loading", "Loading SpellInfo SpellSpecific and AuraState...");
+        sSpellMgr->LoadSpellInfoSpellSpecificAndAuraState();         // must be after LoadSpellRanks
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo SpellSpecific and AuraState...");
-    sSpellMgr->LoadSpellInfoSpellSpecificAndAuraState();         // must be after LoadSpellRanks
+        TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
+        sSpellMgr->LoadSpellLearnSpells();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
+        TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+        TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonuses();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
+        TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
 
-    TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+        TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+        TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    }, { spellInfoTask });
 
-    TC_LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    startupTasks.AddTask("NPC texts", []()
+    {
+        TC_LOG_INFO("server.loading", "Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    }, { localesTask });
 
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    startupTasks.Run(getIntConfig(CONFIG_STARTUP_THREADS));
+    LogStartupTaskReport(startupTasks);
 
     TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
     LoadRandomEnchantmentsTable();
@@ -2131,6 +2195,12 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
     sObjectMgr->LoadGossipMenuItems();
 
+    if (getBoolConfig(CONFIG_WORLD_DATA_SNAPSHOT))
+    {
+        TC_LOG_INFO("server.loading", "Saving world data snapshot...");
+        sObjectMgr->SaveWorldDataSnapshot();
+    }
+
     TC_LOG_INFO("server.loading", "Loading Creature trainers...");
     sObjectMgr->LoadCreatureTrainers();                         // must be after LoadGossipMenuItems
 
@@ -2357,6 +2427,32 @@ void World::SetInitialWorldSettings()
         sLog->SetRealmId(realmId);
 }
 
+void World::LogStartupTaskReport(Trinity::TaskGraph const& tasks)
+{
+    TC_LOG_INFO("server.loading", ">> Startup tasks finished in %u ms", uint32(tasks.GetTotalDuration().count()));
+
+    std::vector<Trinity::TaskGraph::TaskId> byDuration(tasks.GetTaskCount());
+    std::iota(byDuration.begin(), byDuration.end(), 0);
+    std::stable_sort(byDuration.begin(), byDuration.end(), [&tasks](Trinity::TaskGraph::TaskId left, Trinity::TaskGraph::TaskId right)
+    {
+        return tasks.GetTaskDuration(left) > tasks.GetTaskDuration(right);
+    });
+
+    for (Trinity::TaskGraph::TaskId task : byDuration)
+        TC_LOG_INFO("server.loading", "    %-40s %6u ms (started at %u ms)", tasks.GetTaskName(task).c_str(), uint32(tasks.GetTaskDuration(task).count()), uint32(tasks.GetTaskStart(task).count()));
+
+    std::string criticalPath;
+    for (Trinity::TaskGraph::TaskId task : tasks.GetCriticalPath())
+    {
+        if (!criticalPath.empty())
+            criticalPath += " -> ";
+
+        criticalPath += Trinity::StringFormat("%s (%u ms)", tasks.GetTaskName(task).c_str(), uint32(tasks.GetTaskDuration(task).count()));
+    }
+
+    TC_LOG_INFO("server.loading", ">> Startup critical path: %s", criticalPath.c_str());
+}
+
 void World::LoadAutobroadcasts()
 {
     uint32 oldMSTime = getMSTime();
@@ -2518,6 +2614,8 @@ void World::Update(uint32 diff)
     sTerrainMgr.Update(diff);
     sWorldUpdateTime.RecordUpdateTimeDuration("UpdateTerrainMgr");
 
+    sPathRequestService.Update();
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2616,6 +2714,9 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
+    // one copy (and at most one compression) of the packet shared by all receivers
+    std::shared_ptr<SharedWorldPacket const> sharedPacket = std::make_shared<SharedWorldPacket const>(*packet);
+
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2625,7 +2726,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uin
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket);
         }
     }
 }
@@ -41,6 +41,11 @@ class WorldSession;
 class WorldSocket;
 struct Realm;
 
+namespace Trinity
+{
+    class TaskGraph;
+}
+
 // ServerMessages.dbc
 enum ServerMessageType
 {
@@ -101,6 +106,7 @@ enum WorldBoolConfigs
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_GRID_UNLOAD,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_PLAYER_SAVE_SKIP_UNCHANGED,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHANNEL,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP,
@@ -160,6 +166,7 @@ enum WorldBoolConfigs
     CONFIG_QUEST_ENABLE_QUEST_TRACKER,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_MAP_FILES_MEMORY_MAPPED,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_TOLBARAD_ENABLE,
     CONFIG_GUILD_LEVELING_ENABLED,
@@ -171,6 +178,7 @@ enum WorldBoolConfigs
     CONFIG_ALLOW_TRACK_BOTH_RESOURCES,
     CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA,
     CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA,
+    CONFIG_WORLD_DATA_SNAPSHOT,
     CONFIG_RESET_DUEL_COOLDOWNS,
     CONFIG_RESET_DUEL_HEALTH_MANA,
     CONFIG_BASEMAP_LOAD_GRIDS,
@@ -185,6 +193,7 @@ enum WorldBoolConfigs
     CONFIG_CHECK_GOBJECT_LOS,
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_CACHE_DATA_QUERIES,
+    CONFIG_MAP_QUERY_CACHE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -339,6 +348,13 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_ISLAND_UPDATE_THREADS,
+    CONFIG_TERRAIN_PRELOAD_THREADS,
+    CONFIG_TERRAIN_PRELOAD_QUEUE_SIZE,
+    CONFIG_TERRAIN_PRELOAD_DISTANCE,
+    CONFIG_PATHFINDING_THREADS,
+    CONFIG_PATHFINDING_CACHE_SIZE,
+    CONFIG_STARTUP_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -829,6 +845,9 @@ class TC_GAME_API World
         void ResetRandomBG();
         void PerformDailyGuildActions();
         void ResetCurrencyWeekCap();
+
+        // logs per task wall time and the chain of loaders that dominated startup
+        void LogStartupTaskReport(Trinity::TaskGraph const& tasks);
     private:
         World();
         ~World();
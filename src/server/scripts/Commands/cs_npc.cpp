@@ -491,6 +491,7 @@ public:
         stmt->setUInt32(1, lowGuid);
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         handler->SendSysMessage(LANG_WAYPOINT_ADDED);
 
@@ -688,6 +689,7 @@ public:
         stmt->setUInt32(1, creature->GetEntry());
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         return true;
     }
@@ -717,6 +719,7 @@ public:
         stmt->setUInt32(1, creature->GetEntry());
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         handler->SendSysMessage(LANG_VALUE_SAVED_REJOIN);
 
@@ -945,6 +948,7 @@ public:
         stmt->setFloat(3, player->GetOrientation());
         stmt->setUInt32(4, lowguid);
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         // respawn selected creature at the new location
         if (creature)
@@ -1246,6 +1250,7 @@ public:
         stmt->setUInt32(2, guidLow);
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         handler->PSendSysMessage(LANG_COMMAND_WANDER_DISTANCE, option);
         return true;
@@ -1285,6 +1290,7 @@ public:
         stmt->setUInt32(1, guidLow);
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         creature->SetRespawnDelay((uint32)spawnTime);
         handler->PSendSysMessage(LANG_COMMAND_SPAWNTIME, spawnTime);
@@ -216,6 +216,7 @@ public:
         stmt->setUInt32(1, guidLow);
 
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         target->LoadPath(pathid);
         target->SetDefaultMovementType(WAYPOINT_MOTION_TYPE);
@@ -276,6 +277,7 @@ public:
         stmt->setUInt8(0, uint8(IDLE_MOTION_TYPE));
         stmt->setUInt32(1, guidLow);
         WorldDatabase.Execute(stmt);
+        sObjectMgr->InvalidateWorldDataSnapshot();
 
         target->LoadPath(0);
         target->SetDefaultMovementType(IDLE_MOTION_TYPE);
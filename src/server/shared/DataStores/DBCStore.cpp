@@ -17,6 +17,9 @@
 
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
+#include "DBCFileLoader.h"
+#include "MappedFile.h"
+#include <cstring>
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _dataTableEx(nullptr), _indexTableSize(0)
 {
@@ -34,6 +37,22 @@ bool DBCStorageBase::Load(std::string const& path, char**& indexTable)
 {
     indexTable = nullptr;
 
+    // records made only of 4 byte numbers are used straight from the mapped file, no copy is made
+    if (DBCFileLoader::IsInPlaceFormat(_fileFormat))
+    {
+        std::unique_ptr<Trinity::MappedFile> file = std::make_unique<Trinity::MappedFile>();
+        if (file->Open(path))
+        {
+            indexTable = DBCFileLoader::IndexInPlace(file->GetData(), file->GetSize(), _fileFormat, _indexTableSize);
+            if (indexTable)
+            {
+                _fieldCount = uint32(strlen(_fileFormat));
+                _mappedFile = std::move(file);
+                return true;
+            }
+        }
+    }
+
     DBCFileLoader dbc;
     // Check if load was sucessful, only then continue
     if (!dbc.Load(path.c_str(), _fileFormat))
@@ -58,6 +77,14 @@ bool DBCStorageBase::LoadStringsFrom(std::string const& path, char**& indexTable
     if (!indexTable)
         return false;
 
+    // nothing to take from other locales, only check the file is there
+    if (!DBCFileLoader::HasStringFields(_fileFormat))
+    {
+        Trinity::MappedFile file;
+        uint32 records, fields, rowSize, strings;
+        return file.Open(path) && DBCFileLoader::ReadHeader(file.GetData(), file.GetSize(), records, fields, rowSize, strings);
+    }
+
     DBCFileLoader dbc;
     // Check if load was successful, only then continue
     if (!dbc.Load(path.c_str(), _fileFormat))
@@ -20,8 +20,14 @@
 
 #include "Common.h"
 #include "DBStorageIterator.h"
+#include <memory>
 #include <vector>
 
+namespace Trinity
+{
+    class MappedFile;
+}
+
  /// Interface class for common access
 class TC_SHARED_API DBCStorageBase
 {
@@ -46,6 +52,7 @@ class TC_SHARED_API DBCStorageBase
         char* _dataTable;
         char* _dataTableEx;
         std::vector<char*> _stringPool;
+        std::unique_ptr<Trinity::MappedFile> _mappedFile;   // backs the entries instead of _dataTable for formats the file can be used as is
         uint32 _indexTableSize;
 };
 
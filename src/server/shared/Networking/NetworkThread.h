@@ -23,6 +23,7 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "Socket.h"
 #include "Timer.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
@@ -38,7 +39,7 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
+    NetworkThread() : _connections(0), _stopped(false), _writeSyscalls(0), _writtenPackets(0), _thread(nullptr), _ioContext(1),
         _acceptSocket(_ioContext), _updateTimer(_ioContext)
     {
     }
@@ -93,6 +94,15 @@ public:
 
     tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    /// Returns write statistics of all sockets of this thread collected since the last call
+    SocketWriteStatistics ResetWriteStatistics()
+    {
+        SocketWriteStatistics statistics;
+        statistics.Syscalls = _writeSyscalls.exchange(0);
+        statistics.Packets = _writtenPackets.exchange(0);
+        return statistics;
+    }
+
 protected:
     virtual void SocketAdded(std::shared_ptr<SocketType> /*sock*/) { }
     virtual void SocketRemoved(std::shared_ptr<SocketType> /*sock*/) { }
@@ -143,7 +153,13 @@ protected:
 
         _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
         {
-            if (!sock->Update())
+            bool updated = sock->Update();
+
+            SocketWriteStatistics statistics = sock->ResetWriteStatistics();
+            _writeSyscalls += statistics.Syscalls;
+            _writtenPackets += statistics.Packets;
+
+            if (!updated)
             {
                 if (sock->IsOpen())
                     sock->CloseSocket();
@@ -163,6 +179,8 @@ private:
 
     std::atomic<int32> _connections;
     std::atomic<bool> _stopped;
+    std::atomic<uint64> _writeSyscalls;
+    std::atomic<uint64> _writtenPackets;
 
     std::thread* _thread;
 
@@ -20,11 +20,14 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
@@ -34,12 +37,25 @@ using boost::asio::ip::tcp;
 #define TC_SOCKET_USE_IOCP
 #endif
 
+struct SocketWriteStatistics
+{
+    uint64 Syscalls = 0;    // write calls issued to the os
+    uint64 Packets = 0;     // packets queued for writing
+
+    SocketWriteStatistics& operator+=(SocketWriteStatistics const& right)
+    {
+        Syscalls += right.Syscalls;
+        Packets += right.Packets;
+        return *this;
+    }
+};
+
 template<class T>
 class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false), _writeGatherLimit(1)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
     }
@@ -103,7 +119,7 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -131,9 +147,18 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    /// Maximum number of queued buffers written with a single (gathering) write call
+    void SetWriteGatherLimit(std::size_t limit) { _writeGatherLimit = std::max<std::size_t>(limit, 1); }
+
+    /// Returns write statistics collected since the last call
+    SocketWriteStatistics ResetWriteStatistics() { return std::exchange(_writeStatistics, SocketWriteStatistics()); }
+
 protected:
     virtual void OnClose() { }
 
+    /// Packets the derived socket still has to hand over to the write queue, a delayed close waits for them
+    virtual bool HasPendingWrites() const { return false; }
+
     virtual void ReadHandler() = 0;
 
     bool AsyncProcessQueue()
@@ -144,8 +169,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        PrepareWriteBuffers();
+        ++_writeStatistics.Syscalls;
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -164,7 +190,46 @@ protected:
                 GetRemoteIpAddress().to_string().c_str(), err.value(), err.message().c_str());
     }
 
+    /// Packets are counted by the derived socket as one MessageBuffer usually carries many of them
+    void CountQueuedPackets(std::size_t count) { _writeStatistics.Packets += count; }
+
 private:
+    bool IsDelayedCloseReady() const { return _closing && _writeQueue.empty() && !HasPendingWrites(); }
+
+    /// Collects up to _writeGatherLimit queued buffers into one buffer sequence, returns their total size
+    std::size_t PrepareWriteBuffers()
+    {
+        _writeBuffers.clear();
+
+        std::size_t bytes = 0;
+        for (MessageBuffer& buffer : _writeQueue)
+        {
+            if (_writeBuffers.size() >= _writeGatherLimit)
+                break;
+
+            _writeBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytes += buffer.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Removes fully written buffers from the queue, a partially written one stays at its front
+    void ConsumeWrittenBytes(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            std::size_t consumed = std::min(bytes, buffer.GetActiveSize());
+            buffer.ReadCompleted(consumed);
+            bytes -= consumed;
+            if (buffer.GetActiveSize())
+                break;
+
+            _writeQueue.pop_front();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -184,13 +249,11 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            ConsumeWrittenBytes(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
-            else if (_closing)
+            else if (IsDelayedCloseReady())
                 CloseSocket();
         }
         else
@@ -208,40 +271,43 @@ private:
     bool HandleQueue()
     {
         if (_writeQueue.empty())
+        {
+            if (IsDelayedCloseReady())
+                CloseSocket();
             return false;
+        }
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = PrepareWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
+        ++_writeStatistics.Syscalls;
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
-            if (_closing && _writeQueue.empty())
+            _writeQueue.pop_front();
+            if (IsDelayedCloseReady())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
-            if (_closing && _writeQueue.empty())
+            _writeQueue.pop_front();
+            if (IsDelayedCloseReady())
                 CloseSocket();
             return false;
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            ConsumeWrittenBytes(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
-        if (_closing && _writeQueue.empty())
+        ConsumeWrittenBytes(bytesSent);
+        if (IsDelayedCloseReady())
             CloseSocket();
         return !_writeQueue.empty();
     }
@@ -254,12 +320,15 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
 
     bool _isWritingAsync;
+    std::size_t _writeGatherLimit;
+    SocketWriteStatistics _writeStatistics;
 };
 
 #endif // __SOCKET_H__
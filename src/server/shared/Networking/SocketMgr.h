@@ -126,6 +126,16 @@ public:
         return min;
     }
 
+    /// Returns write statistics of all network threads collected since the last call
+    SocketWriteStatistics ResetWriteStatistics()
+    {
+        SocketWriteStatistics statistics;
+        for (int32 i = 0; i < _threadCount; ++i)
+            statistics += _threads[i].ResetWriteStatistics();
+
+        return statistics;
+    }
+
     std::pair<tcp::socket*, uint32> GetSocketForAccept()
     {
         uint32 threadIndex = SelectThreadWithMinConnections();
@@ -19,6 +19,7 @@
 #define _BYTEBUFFER_H
 
 #include "Define.h"
+#include "BufferPool.h"
 #include "ByteConverter.h"
 #include <string>
 #include <vector>
@@ -64,14 +65,12 @@ class TC_SHARED_API ByteBuffer
         static uint8 const InitialBitPos = 8;
 
         // constructor
-        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
+        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storage(Trinity::BufferPool::Acquire(DEFAULT_SIZE))
         {
-            _storage.reserve(DEFAULT_SIZE);
         }
 
-        ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
+        ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storage(Trinity::BufferPool::Acquire(reserve))
         {
-            _storage.reserve(reserve);
         }
 
         ByteBuffer(ByteBuffer&& buf) noexcept : _rpos(buf._rpos), _wpos(buf._wpos),
@@ -82,7 +81,10 @@ class TC_SHARED_API ByteBuffer
         }
 
         ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos),
-            _bitpos(right._bitpos), _curbitval(right._curbitval), _storage(right._storage) { }
+            _bitpos(right._bitpos), _curbitval(right._curbitval), _storage(Trinity::BufferPool::Acquire(right._storage.size()))
+        {
+            _storage.assign(right._storage.begin(), right._storage.end());
+        }
 
         ByteBuffer(MessageBuffer&& buffer);
 
@@ -108,13 +110,17 @@ class TC_SHARED_API ByteBuffer
                 right._rpos = 0;
                 _wpos = right._wpos;
                 right._wpos = 0;
+                Trinity::BufferPool::Release(std::move(_storage));
                 _storage = std::move(right._storage);
             }
 
             return *this;
         }
 
-        virtual ~ByteBuffer() { }
+        virtual ~ByteBuffer()
+        {
+            Trinity::BufferPool::Release(std::move(_storage));
+        }
 
         void clear()
         {
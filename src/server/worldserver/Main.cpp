@@ -26,6 +26,7 @@
 #include "BattlegroundMgr.h"
 #include "BattlenetServerManager.h"
 #include "BigNumber.h"
+#include "BufferPool.h"
 #include "CliRunnable.h"
 #include "Configuration/Config.h"
 #include "DatabaseEnv.h"
@@ -40,6 +41,7 @@
 #include "ObjectAccessor.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
+#include "PathRequestService.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "Resolver.h"
@@ -118,6 +120,9 @@ void SignalHandler(boost::system::error_code const& error, int signalNumber);
 AsyncAcceptor* StartRaSocketAcceptor(Trinity::Asio::IoContext& ioContext);
 bool StartDB();
 void StopDB();
+void LogDatabaseBatchStatistics(std::string const& database, DatabaseBatchStatistics const& statistics);
+void LogDatabaseQueueLatencies(std::string const& database, std::vector<DatabaseQueueLatency> const& latencies);
+void LogPreparedStatementPoolStatistics(std::string const& database, PreparedStatementPool::Statistics const& statistics);
 void WorldUpdateLoop();
 void ClearOnlineAccounts();
 void ShutdownCLIThread(std::thread* cliThread);
@@ -271,6 +276,26 @@ extern int main(int argc, char** argv)
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
         TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+
+        SocketWriteStatistics writeStatistics = sWorldSocketMgr.ResetWriteStatistics();
+        TC_METRIC_VALUE("network_write_syscalls", writeStatistics.Syscalls);
+        if (writeStatistics.Packets)
+            TC_METRIC_VALUE("network_write_syscalls_per_packet", double(writeStatistics.Syscalls) / writeStatistics.Packets);
+
+        Trinity::BufferPool::Statistics bufferPoolStatistics = Trinity::BufferPool::ResetStatistics();
+        TC_METRIC_VALUE("buffer_pool_resident_bytes", bufferPoolStatistics.ResidentBytes);
+        if (uint64 acquires = bufferPoolStatistics.Hits + bufferPoolStatistics.Misses)
+            TC_METRIC_VALUE("buffer_pool_hit_rate", double(bufferPoolStatistics.Hits) / acquires);
+
+        LogDatabaseBatchStatistics("login", LoginDatabase.ResetBatchStatistics());
+        LogDatabaseBatchStatistics("character", CharacterDatabase.ResetBatchStatistics());
+        LogDatabaseBatchStatistics("world", WorldDatabase.ResetBatchStatistics());
+        LogDatabaseQueueLatencies("login", LoginDatabase.ResetQueueLatencies());
+        LogDatabaseQueueLatencies("character", CharacterDatabase.ResetQueueLatencies());
+        LogDatabaseQueueLatencies("world", WorldDatabase.ResetQueueLatencies());
+        LogPreparedStatementPoolStatistics("login", LoginDatabase.ResetPreparedStatementPoolStatistics());
+        LogPreparedStatementPoolStatistics("character", CharacterDatabase.ResetPreparedStatementPoolStatistics());
+        LogPreparedStatementPoolStatistics("world", WorldDatabase.ResetPreparedStatementPoolStatistics());
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -299,6 +324,7 @@ extern int main(int argc, char** argv)
         sInstanceSaveMgr->Unload();
         sOutdoorPvPMgr->Die();                     // unload it before MapManager
         sMapMgr->UnloadAll();                      // unload all grids (including locked in memory)
+        sPathRequestService.Stop();                // stop searching paths before navmeshes are unloaded
         sTerrainMgr.UnloadAll();
     });
 
@@ -662,6 +688,38 @@ void StopDB()
     MySQL::Library_End();
 }
 
+void LogDatabaseBatchStatistics(std::string const& database, DatabaseBatchStatistics const& statistics)
+{
+    if (!statistics.Batches)
+        return;
+
+    // every batched operation would otherwise have been committed on its own
+    uint64 const commitsSaved = statistics.Operations - statistics.Batches;
+    TC_METRIC_VALUE(database + "_db_batch_ratio", double(statistics.Operations) / statistics.Batches);
+    TC_METRIC_VALUE(database + "_db_commits_saved", commitsSaved);
+    TC_METRIC_VALUE(database + "_db_commit_time_saved", commitsSaved * statistics.CommitTime / statistics.Batches);
+}
+
+void LogDatabaseQueueLatencies(std::string const& database, std::vector<DatabaseQueueLatency> const& latencies)
+{
+    for (std::size_t i = 0; i < latencies.size(); ++i)
+    {
+        if (!latencies[i].Operations)
+            continue;
+
+        std::string const shard = database + "_db_queue" + std::to_string(i);
+        TC_METRIC_VALUE(shard + "_operations", latencies[i].Operations);
+        TC_METRIC_VALUE(shard + "_latency_p50", latencies[i].GetPercentile(50));
+        TC_METRIC_VALUE(shard + "_latency_p99", latencies[i].GetPercentile(99));
+    }
+}
+
+void LogPreparedStatementPoolStatistics(std::string const& database, PreparedStatementPool::Statistics const& statistics)
+{
+    TC_METRIC_VALUE(database + "_db_statement_pool_hits", statistics.Hits);
+    TC_METRIC_VALUE(database + "_db_statement_pool_misses", statistics.Misses);
+}
+
 /// Clear 'online' status for all accounts with characters in this realm
 void ClearOnlineAccounts()
 {
@@ -0,0 +1,38 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BenchmarkHelpers_h__
+#define BenchmarkHelpers_h__
+
+#include "Define.h"
+#include <chrono>
+#include <utility>
+
+// Helpers shared by the hidden [.][benchmark] test cases
+namespace Benchmark
+{
+    /// Wall clock time of a single call of f
+    template<typename F>
+    int64 MeasureMicroseconds(F&& f)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::forward<F>(f)();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+#endif // BenchmarkHelpers_h__
@@ -0,0 +1,259 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "BoundingIntervalHierarchy.h"
+#include "VMapManager2.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+
+namespace
+{
+struct BoxBounds
+{
+    void operator()(G3D::AABox const& box, G3D::AABox& bounds) const { bounds = box; }
+};
+
+struct BoxRayCallback
+{
+    explicit BoxRayCallback(std::vector<G3D::AABox> const& boxes) : Boxes(boxes) { }
+
+    bool operator()(G3D::Ray const& ray, uint32 entry, float& maxDist, bool /*stopAtFirst*/)
+    {
+        G3D::AABox const& box = Boxes[entry];
+        float tMin = 0.0f;
+        float tMax = maxDist;
+        for (int i = 0; i < 3; ++i)
+        {
+            float invDir = 1.0f / ray.direction()[i];
+            float t1 = (box.low()[i] - ray.origin()[i]) * invDir;
+            float t2 = (box.high()[i] - ray.origin()[i]) * invDir;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+                return false;
+        }
+
+        maxDist = tMin;
+        return true;
+    }
+
+    std::vector<G3D::AABox> const& Boxes;
+};
+
+std::vector<G3D::AABox> MakeBoxes(std::mt19937& rng, std::size_t count, float area)
+{
+    std::uniform_real_distribution<float> position(0.0f, area);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    std::vector<G3D::AABox> boxes;
+    boxes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        G3D::Vector3 low(position(rng), position(rng), position(rng) * 0.1f);
+        boxes.emplace_back(low, low + G3D::Vector3(size(rng), size(rng), size(rng)));
+    }
+    return boxes;
+}
+
+// segments from points around a center to targets around it, the way area spells check their targets
+void MakeSegments(std::mt19937& rng, std::size_t count, G3D::Vector3 const& center, float radius, std::vector<G3D::Vector3>& starts, std::vector<G3D::Vector3>& ends)
+{
+    std::uniform_real_distribution<float> offset(-radius, radius);
+    std::uniform_real_distribution<float> height(0.0f, radius * 0.1f);
+    starts.resize(count);
+    ends.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        starts[i] = center + G3D::Vector3(offset(rng) * 0.05f, offset(rng) * 0.05f, height(rng));
+        ends[i] = center + G3D::Vector3(offset(rng), offset(rng), height(rng));
+    }
+
+    // packets are built from segments in similar directions, as StaticMapTree::isInLineOfSight does
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](std::size_t left, std::size_t right)
+    {
+        return std::atan2(ends[left].y - starts[left].y, ends[left].x - starts[left].x) < std::atan2(ends[right].y - starts[right].y, ends[right].x - starts[right].x);
+    });
+
+    std::vector<G3D::Vector3> sortedStarts(count), sortedEnds(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sortedStarts[i] = starts[order[i]];
+        sortedEnds[i] = ends[order[i]];
+    }
+
+    starts.swap(sortedStarts);
+    ends.swap(sortedEnds);
+}
+
+bool IntersectSingle(BIH const& tree, BoxRayCallback& callback, G3D::Vector3 const& start, G3D::Vector3 const& end)
+{
+    float maxDist = (end - start).magnitude();
+    G3D::Ray ray = G3D::Ray::fromOriginAndDirection(start, (end - start) / maxDist);
+    bool hit = false;
+    auto recordHit = [&](G3D::Ray const& r, uint32 entry, float& distance, bool stopAtFirst)
+    {
+        bool result = callback(r, entry, distance, stopAtFirst);
+        hit = hit || result;
+        return result;
+    };
+    tree.intersectRay(ray, recordHit, maxDist, true);
+    return hit;
+}
+
+uint32 IntersectPacket(BIH const& tree, BoxRayCallback& callback, G3D::Vector3 const* starts, G3D::Vector3 const* ends, uint32 count)
+{
+    G3D::Ray rays[MAX_RAY_PACKET_SIZE];
+    float maxDist[MAX_RAY_PACKET_SIZE];
+    for (uint32 i = 0; i < count; ++i)
+    {
+        maxDist[i] = (ends[i] - starts[i]).magnitude();
+        rays[i] = G3D::Ray::fromOriginAndDirection(starts[i], (ends[i] - starts[i]) / maxDist[i]);
+    }
+    return tree.intersectRayPacket(rays, maxDist, count, callback);
+}
+}
+
+TEST_CASE("Ray packets hit the same objects as single rays", "[BoundingIntervalHierarchy]")
+{
+    std::mt19937 rng(1337);
+    std::vector<G3D::AABox> boxes = MakeBoxes(rng, 2000, 200.0f);
+    BIH tree;
+    BoxBounds getBounds;
+    tree.build(boxes, getBounds);
+    BoxRayCallback callback(boxes);
+
+    std::vector<G3D::Vector3> starts, ends;
+    MakeSegments(rng, 4096, G3D::Vector3(100.0f, 100.0f, 5.0f), 100.0f, starts, ends);
+
+    SECTION("Rays starting outside the tree bounds")
+    {
+        for (G3D::Vector3& start : starts)
+            start.z += 100.0f;
+    }
+
+    SECTION("Axis aligned rays")
+    {
+        for (std::size_t i = 0; i < starts.size(); ++i)
+            ends[i] = G3D::Vector3(ends[i].x, starts[i].y, starts[i].z);
+    }
+
+    SECTION("Axis aligned rays starting on split planes")
+    {
+        // split planes are box faces, a ray in such a plane gets 0 * inf distances for it
+        for (std::size_t i = 0; i < starts.size(); ++i)
+        {
+            G3D::AABox const& box = boxes[i % boxes.size()];
+            starts[i] = G3D::Vector3(starts[i].x, box.high().y, (i & 1) ? box.low().z : box.high().z);
+            ends[i] = G3D::Vector3(ends[i].x, starts[i].y, starts[i].z);
+        }
+    }
+
+    uint32 hits = 0;
+    for (std::size_t first = 0; first < starts.size(); first += MAX_RAY_PACKET_SIZE)
+    {
+        uint32 count = uint32(std::min<std::size_t>(MAX_RAY_PACKET_SIZE, starts.size() - first));
+        uint32 hitMask = IntersectPacket(tree, callback, &starts[first], &ends[first], count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            bool hit = IntersectSingle(tree, callback, starts[first + i], ends[first + i]);
+            REQUIRE(((hitMask >> i) & 1) == uint32(hit));
+            hits += hit;
+        }
+    }
+
+    // both hits and misses must have been compared
+    CHECK(hits > 0);
+    CHECK(hits < starts.size());
+}
+
+TEST_CASE("Ray packet benchmark", "[.][benchmark][BoundingIntervalHierarchy]")
+{
+    std::mt19937 rng(1337);
+    std::vector<G3D::AABox> boxes = MakeBoxes(rng, 50000, 2000.0f);
+    BIH tree;
+    BoxBounds getBounds;
+    tree.build(boxes, getBounds);
+    BoxRayCallback callback(boxes);
+
+    std::size_t const rayCount = 1000000;
+    std::vector<G3D::Vector3> starts, ends;
+    MakeSegments(rng, rayCount, G3D::Vector3(1000.0f, 1000.0f, 10.0f), 60.0f, starts, ends);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t singleHits = 0;
+    for (std::size_t i = 0; i < rayCount; ++i)
+        singleHits += IntersectSingle(tree, callback, starts[i], ends[i]);
+    auto single = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::size_t packetHits = 0;
+    for (std::size_t first = 0; first < rayCount; first += MAX_RAY_PACKET_SIZE)
+    {
+        uint32 count = uint32(std::min<std::size_t>(MAX_RAY_PACKET_SIZE, rayCount - first));
+        uint32 hitMask = IntersectPacket(tree, callback, &starts[first], &ends[first], count);
+        for (uint32 i = 0; i < count; ++i)
+            packetHits += (hitMask >> i) & 1;
+    }
+    auto packet = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    WARN(rayCount << " rays through " << boxes.size() << " boxes: single rays " << single << "ms, packets of " << MAX_RAY_PACKET_SIZE << " " << packet << "ms");
+    CHECK(packetHits == singleHits);
+}
+
+TEST_CASE("Line of sight batch benchmark on extracted vmaps", "[.][benchmark][BoundingIntervalHierarchy]")
+{
+    // Stormwind, grids around (-8900, 560), needs the vmaps directory of an extracted client in TC_VMAPS_PATH
+    char const* vmapsPath = std::getenv("TC_VMAPS_PATH");
+    if (!vmapsPath)
+    {
+        WARN("TC_VMAPS_PATH is not set, skipped");
+        return;
+    }
+
+    VMAP::VMapManager2 vmgr;
+    vmgr.InitializeThreadUnsafe({ { 0u, { } } });
+    for (int gx = 47; gx <= 49; ++gx)
+        for (int gy = 29; gy <= 31; ++gy)
+            vmgr.loadMap(vmapsPath, 0, gx, gy);
+
+    std::size_t const segmentCount = 200000;
+    std::mt19937 rng(1337);
+    std::vector<G3D::Vector3> starts, ends;
+    MakeSegments(rng, segmentCount, G3D::Vector3(-8900.0f, 560.0f, 95.0f), 40.0f, starts, ends);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<bool> single(segmentCount);
+    for (std::size_t i = 0; i < segmentCount; ++i)
+        single[i] = vmgr.isInLineOfSight(0, starts[i].x, starts[i].y, starts[i].z, ends[i].x, ends[i].y, ends[i].z, VMAP::ModelIgnoreFlags::M2);
+    auto singleTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<bool> batch(segmentCount, true);
+    vmgr.isInLineOfSight(0, starts.data(), ends.data(), segmentCount, VMAP::ModelIgnoreFlags::M2, batch);
+    auto batchTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    WARN(segmentCount << " line of sight checks: single " << singleTime << "ms, batched " << batchTime << "ms, "
+        << std::count(single.begin(), single.end(), true) << " visible");
+    CHECK(batch == single);
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "BufferPool.h"
+#include "MessageBuffer.h"
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Released buffers are reused for the same size class", "[BufferPool]")
+{
+    Trinity::BufferPool::ResetStatistics();
+
+    std::vector<uint8> storage = Trinity::BufferPool::Acquire(1000);
+    REQUIRE(storage.empty());
+    REQUIRE(storage.capacity() >= 1024);
+    uint8 const* data = storage.data();
+
+    storage.resize(1000);
+    Trinity::BufferPool::Release(std::move(storage));
+
+    std::vector<uint8> reused = Trinity::BufferPool::Acquire(700);
+    REQUIRE(reused.empty());
+    REQUIRE(reused.data() == data);
+
+    Trinity::BufferPool::Statistics statistics = Trinity::BufferPool::ResetStatistics();
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 1);
+
+    SECTION("Smaller size class does not take larger buffers")
+    {
+        Trinity::BufferPool::Release(std::move(reused));
+        std::vector<uint8> small = Trinity::BufferPool::Acquire(100);
+        REQUIRE(small.data() != data);
+        REQUIRE(small.capacity() >= 256);
+    }
+
+    SECTION("Oversized buffers are not kept")
+    {
+        std::vector<uint8> huge = Trinity::BufferPool::Acquire(1024 * 1024);
+        REQUIRE(huge.capacity() >= 1024 * 1024);
+
+        uint64 resident = Trinity::BufferPool::ResetStatistics().ResidentBytes;
+        Trinity::BufferPool::Release(std::move(huge));
+        REQUIRE(Trinity::BufferPool::ResetStatistics().ResidentBytes == resident);
+    }
+}
+
+TEST_CASE("Buffers released on another thread come back through the shared pool", "[BufferPool]")
+{
+    std::vector<std::vector<uint8>> buffers;
+    for (std::size_t i = 0; i < 64; ++i)
+        buffers.push_back(Trinity::BufferPool::Acquire(16384));
+
+    // thread exit hands its cache over to the shared pool
+    std::thread([&buffers]()
+    {
+        for (std::vector<uint8>& storage : buffers)
+            Trinity::BufferPool::Release(std::move(storage));
+    }).join();
+
+    Trinity::BufferPool::ResetStatistics();
+    std::vector<uint8> storage = Trinity::BufferPool::Acquire(16384);
+    REQUIRE(Trinity::BufferPool::ResetStatistics().Hits == 1);
+}
+
+TEST_CASE("MessageBuffer storage is pooled", "[BufferPool]")
+{
+    uint8 const* data = nullptr;
+    {
+        MessageBuffer buffer(4096);
+        data = buffer.GetBasePointer();
+    }
+
+    MessageBuffer buffer(3000);
+    REQUIRE(buffer.GetBufferSize() == 3000);
+    REQUIRE(buffer.GetBasePointer() == data);
+}
+
+TEST_CASE("Packet buffer allocation benchmark", "[.][benchmark][BufferPool]")
+{
+    std::size_t const packets = 1000000;
+    std::size_t const sizes[] = { 40, 200, 900, 3000, 12000 };
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < packets; ++i)
+    {
+        std::vector<uint8> storage;
+        storage.reserve(sizes[i % 5]);
+        storage.resize(sizes[i % 5]);
+    }
+    auto heap = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    Trinity::BufferPool::ResetStatistics();
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < packets; ++i)
+    {
+        std::vector<uint8> storage = Trinity::BufferPool::Acquire(sizes[i % 5]);
+        storage.resize(sizes[i % 5]);
+        Trinity::BufferPool::Release(std::move(storage));
+    }
+    auto pooled = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    Trinity::BufferPool::Statistics statistics = Trinity::BufferPool::ResetStatistics();
+    WARN(packets << " packet buffers: heap " << heap << "us, pooled " << pooled << "us, hit rate " << double(statistics.Hits) / (statistics.Hits + statistics.Misses) << ", resident " << statistics.ResidentBytes << " bytes");
+    CHECK(statistics.Hits >= packets - 5);
+}
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "DBCFileLoader.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct TestEntry
+{
+    uint32 ID;
+    int32 Value;
+    float Multiplier;
+};
+
+std::vector<uint8> MakeDBC(std::vector<TestEntry> const& entries, uint32 fieldCount = 3)
+{
+    uint32 const header[5] = { 0x43424457, uint32(entries.size()), fieldCount, uint32(sizeof(TestEntry)), 1 };
+    std::vector<uint8> file(sizeof(header) + entries.size() * sizeof(TestEntry) + 1, 0);
+    memcpy(file.data(), header, sizeof(header));
+    if (!entries.empty())
+        memcpy(file.data() + sizeof(header), entries.data(), entries.size() * sizeof(TestEntry));
+    return file;
+}
+}
+
+TEST_CASE("Only plain 4 byte formats are used in place", "[DBCFileLoader]")
+{
+    REQUIRE(DBCFileLoader::IsInPlaceFormat("nif"));
+    REQUIRE(DBCFileLoader::IsInPlaceFormat("fff"));
+    REQUIRE_FALSE(DBCFileLoader::IsInPlaceFormat("nsi"));
+    REQUIRE_FALSE(DBCFileLoader::IsInPlaceFormat("nxi"));
+    REQUIRE_FALSE(DBCFileLoader::IsInPlaceFormat("nbi"));
+    REQUIRE_FALSE(DBCFileLoader::IsInPlaceFormat("dii"));
+    REQUIRE_FALSE(DBCFileLoader::IsInPlaceFormat(""));
+
+    REQUIRE(DBCFileLoader::HasStringFields("nsi"));
+    REQUIRE_FALSE(DBCFileLoader::HasStringFields("nif"));
+}
+
+TEST_CASE("Index table points into the file image", "[DBCFileLoader]")
+{
+    std::vector<uint8> file = MakeDBC({ { 3, -7, 0.5f }, { 9, 12, 2.0f } });
+
+    uint32 records = 0;
+    std::unique_ptr<char*[]> indexTable(DBCFileLoader::IndexInPlace(file.data(), file.size(), "nif", records));
+    REQUIRE(indexTable);
+    REQUIRE(records == 10);
+    REQUIRE(indexTable[0] == nullptr);
+    REQUIRE(indexTable[4] == nullptr);
+
+    TestEntry const* entry = reinterpret_cast<TestEntry const*>(indexTable[9]);
+    REQUIRE(reinterpret_cast<uint8 const*>(entry) == file.data() + 20 + sizeof(TestEntry));
+    REQUIRE(entry->Value == 12);
+    REQUIRE(entry->Multiplier == 2.0f);
+    REQUIRE(reinterpret_cast<TestEntry const*>(indexTable[3])->Value == -7);
+
+    SECTION("Formats without index use the record number")
+    {
+        std::unique_ptr<char*[]> rows(DBCFileLoader::IndexInPlace(file.data(), file.size(), "iif", records));
+        REQUIRE(records == 2);
+        REQUIRE(reinterpret_cast<TestEntry const*>(rows[1])->ID == 9);
+    }
+
+    SECTION("Mismatching files are rejected")
+    {
+        REQUIRE(DBCFileLoader::IndexInPlace(file.data(), file.size(), "ni", records) == nullptr);
+        REQUIRE(DBCFileLoader::IndexInPlace(file.data(), file.size() - 2, "nif", records) == nullptr);
+
+        std::vector<uint8> wrongFields = MakeDBC({ { 1, 1, 1.0f } }, 4);
+        REQUIRE(DBCFileLoader::IndexInPlace(wrongFields.data(), wrongFields.size(), "nif", records) == nullptr);
+    }
+}
+
+TEST_CASE("Mapped files are private copies", "[DBCFileLoader]")
+{
+    std::vector<uint8> image = MakeDBC({ { 1, 5, 1.0f } });
+    std::string const path = "test-DBCFileLoader.dbc";
+    FILE* f = fopen(path.c_str(), "wb");
+    REQUIRE(f);
+    fwrite(image.data(), image.size(), 1, f);
+    fclose(f);
+
+    {
+        Trinity::MappedFile file;
+        REQUIRE(file.Open(path));
+        REQUIRE(file.GetSize() == image.size());
+
+        uint32 records = 0;
+        std::unique_ptr<char*[]> indexTable(DBCFileLoader::IndexInPlace(file.GetData(), file.GetSize(), "nif", records));
+        REQUIRE(indexTable);
+        reinterpret_cast<TestEntry*>(indexTable[1])->Value = 42;
+    }
+
+    Trinity::MappedFile file;
+    REQUIRE(file.Open(path));
+    REQUIRE(memcmp(file.GetData(), image.data(), image.size()) == 0);
+    file.Close();
+    REQUIRE_FALSE(file.IsOpen());
+
+    std::remove(path.c_str());
+    REQUIRE_FALSE(file.Open(path));
+}
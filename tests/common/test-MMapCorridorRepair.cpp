@@ -0,0 +1,206 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "BenchmarkHelpers.h"
+#include "DetourNavMeshQuery.h"
+#include "MMapManager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+uint32 const MaxPathLength = 74;           // MAX_PATH_LENGTH of PathGenerator
+uint32 const TickCount = 500;              // 400 ms chase movement intervals
+float const TargetStep = 7.0f * 0.4f;      // run speed of the target per interval
+float const ChaserStep = 8.0f * 0.4f;
+
+// detour positions are in (y, z, x) order
+struct NavPoint
+{
+    NavPoint() : Coords() { }
+    NavPoint(float x, float y, float z) : Coords{ y, z, x } { }
+
+    float Coords[3];
+};
+
+dtPolyRef FindPoly(dtNavMeshQuery const* query, dtQueryFilter const& filter, NavPoint const& point)
+{
+    float const extents[3] = { 3.0f, 5.0f, 3.0f };
+    float closestPoint[3];
+    dtPolyRef polyRef = 0;
+    query->findNearestPoly(point.Coords, extents, &filter, &polyRef, closestPoint);
+    return polyRef;
+}
+
+struct Corridor
+{
+    Corridor() : Length(0) { }
+
+    dtPolyRef Polys[MaxPathLength];
+    uint32 Length;
+};
+
+// same cases as PathGenerator::BuildPolyPath for a kept poly path: cut it, search only the last 20% again or search all of it
+bool RepairCorridor(dtNavMeshQuery const* query, dtQueryFilter const& filter, Corridor& corridor, dtPolyRef startPoly, dtPolyRef endPoly,
+    NavPoint const& start, NavPoint const& end)
+{
+    dtPolyRef* startItr = std::find(corridor.Polys, corridor.Polys + corridor.Length, startPoly);
+    if (startItr != corridor.Polys + corridor.Length)
+    {
+        uint32 startIndex = uint32(startItr - corridor.Polys);
+        corridor.Length -= startIndex;
+        std::memmove(corridor.Polys, corridor.Polys + startIndex, corridor.Length * sizeof(dtPolyRef));
+
+        dtPolyRef* endItr = std::find(corridor.Polys, corridor.Polys + corridor.Length, endPoly);
+        if (endItr != corridor.Polys + corridor.Length)
+        {
+            corridor.Length = uint32(endItr - corridor.Polys) + 1;
+            return true;
+        }
+
+        uint32 prefixLength = uint32(corridor.Length * 0.8f + 0.5f);
+        float suffixStart[3];
+        if (dtStatusSucceed(query->closestPointOnPoly(corridor.Polys[prefixLength - 1], end.Coords, suffixStart, nullptr)))
+        {
+            int suffixLength = 0;
+            query->findPath(corridor.Polys[prefixLength - 1], endPoly, suffixStart, end.Coords, &filter, corridor.Polys + prefixLength - 1, &suffixLength, MaxPathLength - prefixLength);
+            if (suffixLength)
+            {
+                corridor.Length = prefixLength + suffixLength - 1;
+                return true;
+            }
+        }
+    }
+
+    int length = 0;
+    query->findPath(startPoly, endPoly, start.Coords, end.Coords, &filter, corridor.Polys, &length, MaxPathLength);
+    corridor.Length = uint32(length);
+    return false;
+}
+}
+
+TEST_CASE("Mass chase corridor repair benchmark on extracted mmaps", "[.][benchmark][MMapManager]")
+{
+    // 40 creatures chasing a player kiting in circles in Stormwind, grids around (-8900, 560),
+    // needs the data directory of an extracted client with its mmaps directory in TC_DATA_PATH
+    char const* dataPath = std::getenv("TC_DATA_PATH");
+    if (!dataPath)
+    {
+        WARN("TC_DATA_PATH is not set, skipped");
+        return;
+    }
+
+    std::string basePath = dataPath;
+    if (!basePath.empty() && basePath.back() != '/')
+        basePath += '/';
+
+    MMAP::MMapManager mmap;
+    mmap.InitializeThreadUnsafe({ { 0u, { } } });
+    for (int gx = 47; gx <= 49; ++gx)
+        for (int gy = 29; gy <= 31; ++gy)
+            mmap.loadMap(basePath, 0, gx, gy);
+
+    dtNavMeshQuery const* query = mmap.GetNavMeshQuery(0);
+    REQUIRE(query);
+
+    dtQueryFilter filter;
+    filter.setIncludeFlags(0xFFFF);
+    filter.setExcludeFlags(0);
+
+    // both ways see the same positions, chasers run straight at the target instead of along their paths
+    float const centerX = -8900.0f, centerY = 560.0f, height = 95.0f, kiteRadius = 20.0f;
+    std::vector<NavPoint> targetPath(TickCount);
+    for (uint32 tick = 0; tick < TickCount; ++tick)
+    {
+        float angle = tick * TargetStep / kiteRadius;
+        targetPath[tick] = NavPoint(centerX + std::cos(angle) * kiteRadius, centerY + std::sin(angle) * kiteRadius, height);
+    }
+
+    std::size_t const chaserCount = 40;
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * float(M_PI));
+    std::uniform_real_distribution<float> distance(15.0f, 30.0f);
+    std::vector<std::vector<NavPoint>> chaserPaths(chaserCount, std::vector<NavPoint>(TickCount));
+    for (std::vector<NavPoint>& chaserPath : chaserPaths)
+    {
+        float a = angle(rng), d = distance(rng);
+        float x = targetPath[0].Coords[2] + std::cos(a) * d, y = targetPath[0].Coords[0] + std::sin(a) * d;
+        for (uint32 tick = 0; tick < TickCount; ++tick)
+        {
+            chaserPath[tick] = NavPoint(x, y, height);
+            float dx = targetPath[tick].Coords[2] - x, dy = targetPath[tick].Coords[0] - y;
+            float length = std::sqrt(dx * dx + dy * dy);
+            float step = std::min(ChaserStep, std::max(length - 3.0f, 0.0f));
+            if (length > 0.0f)
+            {
+                x += dx / length * step;
+                y += dy / length * step;
+            }
+        }
+    }
+
+    std::size_t fullReached = 0;
+    int64 fullTime = Benchmark::MeasureMicroseconds([&]
+    {
+        Corridor corridor;
+        for (uint32 tick = 0; tick < TickCount; ++tick)
+        {
+            dtPolyRef endPoly = FindPoly(query, filter, targetPath[tick]);
+            for (std::vector<NavPoint> const& chaserPath : chaserPaths)
+            {
+                dtPolyRef startPoly = FindPoly(query, filter, chaserPath[tick]);
+                if (!startPoly || !endPoly)
+                    continue;
+
+                int length = 0;
+                query->findPath(startPoly, endPoly, chaserPath[tick].Coords, targetPath[tick].Coords, &filter, corridor.Polys, &length, MaxPathLength);
+                fullReached += length && corridor.Polys[length - 1] == endPoly;
+            }
+        }
+    });
+
+    std::size_t repairedReached = 0, repairs = 0;
+    int64 repairTime = Benchmark::MeasureMicroseconds([&]
+    {
+        std::vector<Corridor> corridors(chaserCount);
+        for (uint32 tick = 0; tick < TickCount; ++tick)
+        {
+            dtPolyRef endPoly = FindPoly(query, filter, targetPath[tick]);
+            for (std::size_t i = 0; i < chaserCount; ++i)
+            {
+                dtPolyRef startPoly = FindPoly(query, filter, chaserPaths[i][tick]);
+                if (!startPoly || !endPoly)
+                    continue;
+
+                Corridor& corridor = corridors[i];
+                repairs += RepairCorridor(query, filter, corridor, startPoly, endPoly, chaserPaths[i][tick], targetPath[tick]);
+                repairedReached += corridor.Length && corridor.Polys[corridor.Length - 1] == endPoly;
+            }
+        }
+    });
+
+    WARN(chaserCount << " chasers over " << TickCount << " intervals: searched every time " << fullTime / 1000 << "ms ("
+        << fullReached << " paths reaching the target), repaired " << repairTime / 1000 << "ms (" << repairs << " repairs, "
+        << repairedReached << " paths reaching the target)");
+    CHECK(repairs > 0);
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "BenchmarkHelpers.h"
+#include "PositionBatch.h"
+#include <memory>
+#include <random>
+
+TEST_CASE("Filter uses the larger sight range of both sides", "[PositionBatch]")
+{
+    Trinity::PositionBatch<int> batch;
+    batch.Add(0, 10.0f, 0.0f, 0.0f, 5.0f);
+    batch.Add(1, 10.0f, 0.0f, 0.0f, 20.0f);
+    batch.Add(2, 30.0f, 0.0f, 0.0f, 5.0f);
+    batch.Add(3, 0.0f, 12.0f, 1.5f, 0.0f);
+
+    std::vector<uint8> inRange;
+    REQUIRE(batch.FilterWithinMutualRange2d(0.0f, 0.0f, 0.5f, 8.0f, inRange) == 1);
+    REQUIRE(inRange == std::vector<uint8>{ 0, 1, 0, 0 });
+
+    SECTION("Reach of both sides counts towards the range")
+    {
+        REQUIRE(batch.FilterWithinMutualRange2d(0.0f, 0.0f, 0.5f, 10.0f, inRange) == 3);
+        REQUIRE(inRange == std::vector<uint8>{ 1, 1, 0, 1 });
+    }
+
+    SECTION("Cleared batch matches nothing")
+    {
+        batch.Clear();
+        REQUIRE(batch.FilterWithinMutualRange2d(0.0f, 0.0f, 0.5f, 10.0f, inRange) == 0);
+        REQUIRE(inRange.empty());
+    }
+}
+
+namespace
+{
+// Position and ranges only reachable through virtual calls, as they are on WorldObject
+struct BenchmarkObject
+{
+    BenchmarkObject(float x, float y, float reach, float range) : X(x), Y(y), Reach(reach), Range(range) { }
+    virtual ~BenchmarkObject() = default;
+
+    virtual float GetPositionX() const { return X; }
+    virtual float GetPositionY() const { return Y; }
+    virtual float GetCombatReach() const { return Reach; }
+    virtual float GetSightRange() const { return Range; }
+
+    float X, Y, Reach, Range;
+};
+
+bool IsWithinSight(BenchmarkObject const* seer, BenchmarkObject const* target)
+{
+    float dx = seer->GetPositionX() - target->GetPositionX();
+    float dy = seer->GetPositionY() - target->GetPositionY();
+    float maxDist = seer->GetSightRange() + seer->GetCombatReach() + target->GetCombatReach();
+    return dx * dx + dy * dy < maxDist * maxDist;
+}
+}
+
+TEST_CASE("Relocation range check benchmark", "[.][benchmark][PositionBatch]")
+{
+    // 500 units spread over 3x3 cells (SIZE_OF_GRID_CELL = 533.3333 / 64) around the relocated one
+    float const cellSize = 533.3333f / 64.0f;
+    std::size_t const unitCount = 500;
+
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> offset(0.0f, cellSize);
+    std::uniform_real_distribution<float> sight(2.0f, 10.0f);
+
+    std::vector<std::vector<std::unique_ptr<BenchmarkObject>>> cells(9);
+    for (std::size_t i = 0; i < unitCount; ++i)
+    {
+        std::size_t cell = i % cells.size();
+        cells[cell].push_back(std::make_unique<BenchmarkObject>((cell % 3) * cellSize + offset(rng), (cell / 3) * cellSize + offset(rng), 0.5f, sight(rng)));
+    }
+
+    BenchmarkObject relocated(1.5f * cellSize, 1.5f * cellSize, 0.5f, 8.0f);
+
+    std::size_t const iterations = 2000;
+    std::size_t scalarMatches = 0;
+    int64 scalar = Benchmark::MeasureMicroseconds([&]()
+    {
+        for (std::size_t n = 0; n < iterations; ++n)
+            for (auto const& cell : cells)
+                for (auto const& object : cell)
+                    if (IsWithinSight(&relocated, object.get()) || IsWithinSight(object.get(), &relocated))
+                        ++scalarMatches;
+    });
+
+    Trinity::PositionBatch<BenchmarkObject*> batch;
+    std::vector<uint8> inRange;
+    std::size_t batchMatches = 0;
+    int64 batched = Benchmark::MeasureMicroseconds([&]()
+    {
+        for (std::size_t n = 0; n < iterations; ++n)
+        {
+            for (auto const& cell : cells)
+            {
+                batch.Clear();
+                for (auto const& object : cell)
+                    batch.Add(object.get(), object->GetPositionX(), object->GetPositionY(), object->GetCombatReach(), object->GetSightRange());
+
+                batchMatches += batch.FilterWithinMutualRange2d(relocated.GetPositionX(), relocated.GetPositionY(), relocated.GetCombatReach(), relocated.GetSightRange(), inRange);
+            }
+        }
+    });
+
+    WARN(unitCount << " units in 9 cells, " << iterations << " relocations: per pair " << scalar << "us, batched " << batched << "us");
+    CHECK(batchMatches >= scalarMatches);
+}
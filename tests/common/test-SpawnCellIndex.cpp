@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "SpawnCellIndex.h"
+
+typedef Trinity::SpawnCellIndex<uint32, int> TestIndex;
+
+namespace
+{
+std::vector<uint32> Collect(TestIndex const& index, TestIndex::KeyType key)
+{
+    std::vector<uint32> ids;
+    index.ForEach(key, [&ids](uint32 id, int value)
+    {
+        REQUIRE(value == int(id) * 10);
+        ids.push_back(id);
+    });
+    return ids;
+}
+}
+
+TEST_CASE("Spawns are visited per cell", "[SpawnCellIndex]")
+{
+    TestIndex index;
+    index.Insert(TestIndex::MakeKey(1, 5), 30, 300);
+    index.Insert(TestIndex::MakeKey(1, 5), 10, 100);
+    index.Insert(TestIndex::MakeKey(1, 6), 20, 200);
+    index.Insert(TestIndex::MakeKey(2, 5), 40, 400);
+    index.Insert(TestIndex::MakeKey(1, 5), 10, 100);
+
+    REQUIRE(index.GetSize() == 4);
+    REQUIRE(Collect(index, TestIndex::MakeKey(1, 5)).size() == 2);
+
+    index.Build();
+    REQUIRE(index.GetCellCount() == 3);
+    REQUIRE(Collect(index, TestIndex::MakeKey(1, 5)) == std::vector<uint32>{ 10, 30 });
+    REQUIRE(Collect(index, TestIndex::MakeKey(1, 6)) == std::vector<uint32>{ 20 });
+    REQUIRE(Collect(index, TestIndex::MakeKey(1, 7)).empty());
+
+    SECTION("Changes after build are visible before the next build")
+    {
+        index.Insert(TestIndex::MakeKey(1, 5), 50, 500);
+        REQUIRE(index.Remove(TestIndex::MakeKey(1, 5), 10));
+        REQUIRE_FALSE(index.Remove(TestIndex::MakeKey(1, 5), 10));
+        REQUIRE(Collect(index, TestIndex::MakeKey(1, 5)) == std::vector<uint32>{ 30, 50 });
+        REQUIRE(index.GetSize() == 4);
+
+        index.Build();
+        REQUIRE(Collect(index, TestIndex::MakeKey(1, 5)) == std::vector<uint32>{ 30, 50 });
+        REQUIRE(index.GetSize() == 4);
+    }
+
+    SECTION("Range visits every cell of a map")
+    {
+        index.Insert(TestIndex::MakeKey(1, 9), 60, 600);
+
+        std::vector<uint32> ids;
+        index.ForEachInRange(TestIndex::MakeKey(1, 0), TestIndex::MakeKey(1, 0xFFFFFFFF), [&ids](uint32 id, int) { ids.push_back(id); });
+        REQUIRE(ids == std::vector<uint32>{ 10, 30, 20, 60 });
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "TaskGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+TEST_CASE("Tasks run after their dependencies", "[TaskGraph]")
+{
+    Trinity::TaskGraph graph;
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](int value) { return [&, value]() { std::lock_guard<std::mutex> guard(lock); order.push_back(value); }; };
+
+    Trinity::TaskGraph::TaskId a = graph.AddTask("a", record(0));
+    Trinity::TaskGraph::TaskId b = graph.AddTask("b", record(1), { a });
+    Trinity::TaskGraph::TaskId c = graph.AddTask("c", record(2));
+    graph.AddTask("d", record(3), { b, c });
+
+    REQUIRE(graph.GetTaskCount() == 4);
+    REQUIRE(graph.GetTaskName(b) == "b");
+
+    SECTION("Single thread runs tasks in order")
+    {
+        graph.Run(1);
+        REQUIRE(order == std::vector<int>{ 0, 1, 2, 3 });
+    }
+
+    SECTION("Multiple threads respect dependencies")
+    {
+        graph.Run(4);
+        REQUIRE(order.size() == 4);
+        auto position = [&](int value) { return std::find(order.begin(), order.end(), value) - order.begin(); };
+        REQUIRE(position(0) < position(1));
+        REQUIRE(position(1) < position(3));
+        REQUIRE(position(2) < position(3));
+    }
+
+    SECTION("Graph can be run again")
+    {
+        graph.Run(2);
+        graph.Run(2);
+        REQUIRE(order.size() == 8);
+    }
+}
+
+TEST_CASE("Independent tasks run concurrently", "[TaskGraph]")
+{
+    Trinity::TaskGraph graph;
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.AddTask("task", [&]()
+        {
+            int now = ++running;
+            int seen = maxRunning;
+            while (now > seen && !maxRunning.compare_exchange_weak(seen, now))
+                ;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --running;
+        });
+    }
+
+    graph.Run(4);
+    REQUIRE(maxRunning > 1);
+}
+
+TEST_CASE("Critical path follows the dependency that finished last", "[TaskGraph]")
+{
+    auto sleep = [](int ms) { return [ms]() { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }; };
+
+    Trinity::TaskGraph graph;
+    Trinity::TaskGraph::TaskId fast = graph.AddTask("fast", sleep(1));
+    Trinity::TaskGraph::TaskId slow = graph.AddTask("slow", sleep(40));
+    Trinity::TaskGraph::TaskId middle = graph.AddTask("middle", sleep(5), { slow });
+    Trinity::TaskGraph::TaskId last = graph.AddTask("last", sleep(5), { fast, middle });
+    graph.AddTask("side", sleep(1), { fast });
+
+    graph.Run(4);
+
+    REQUIRE(graph.GetCriticalPath() == std::vector<Trinity::TaskGraph::TaskId>{ slow, middle, last });
+    REQUIRE(graph.GetTaskDuration(slow) >= Milliseconds(40));
+    REQUIRE(graph.GetTaskStart(last) >= Milliseconds(45));
+    REQUIRE(graph.GetTotalDuration() >= Milliseconds(50));
+}
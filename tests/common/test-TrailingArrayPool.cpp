@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "TrailingArrayPool.h"
+#include <vector>
+
+namespace
+{
+struct Parameter
+{
+    uint64 Value = 0;
+    std::vector<uint8> Binary;
+};
+
+typedef Trinity::TrailingArrayPool<Parameter> ParameterPool;
+
+struct PooledStatement
+{
+    PooledStatement(uint32 index) : Index(index), Parameters(ParameterPool::GetElements(this)), Count(ParameterPool::GetElementCount(this)) { }
+    virtual ~PooledStatement() = default;
+
+    static void* operator new(std::size_t /*size*/, ParameterPool& pool, uint8 count) { return pool.Acquire(count); }
+    static void operator delete(void* ptr, ParameterPool& /*pool*/, uint8 /*count*/) { ParameterPool::Release(ptr); }
+    static void operator delete(void* ptr) { ParameterPool::Release(ptr); }
+
+    uint32 Index;
+    Parameter* Parameters;
+    uint8 Count;
+};
+}
+
+TEST_CASE("Released blocks are reused per element count", "[TrailingArrayPool]")
+{
+    ParameterPool pool(sizeof(PooledStatement), 2);
+
+    PooledStatement* first = new (pool, 3) PooledStatement(1);
+    REQUIRE(first->Count == 3);
+    first->Parameters[2].Binary.assign(64, 1);
+    uint8 const* binary = first->Parameters[2].Binary.data();
+    delete first;
+
+    SECTION("Same count gets the same block and keeps element storage")
+    {
+        PooledStatement* second = new (pool, 3) PooledStatement(2);
+        REQUIRE(second == first);
+        REQUIRE(second->Index == 2);
+        REQUIRE(second->Parameters[2].Binary.data() == binary);
+        delete second;
+
+        ParameterPool::Statistics statistics = pool.ResetStatistics();
+        REQUIRE(statistics.Hits == 1);
+        REQUIRE(statistics.Misses == 1);
+    }
+
+    SECTION("Other counts allocate their own blocks")
+    {
+        PooledStatement* other = new (pool, 4) PooledStatement(3);
+        REQUIRE(other->Count == 4);
+        REQUIRE(pool.ResetStatistics().Misses == 2);
+        delete other;
+    }
+
+    SECTION("Blocks past the pool limit are freed")
+    {
+        std::vector<PooledStatement*> statements;
+        for (uint32 i = 0; i < 4; ++i)
+            statements.push_back(new (pool, 3) PooledStatement(i));
+
+        for (PooledStatement* statement : statements)
+            delete statement;
+
+        pool.ResetStatistics();
+        for (uint32 i = 0; i < 4; ++i)
+            statements[i] = new (pool, 3) PooledStatement(i);
+
+        ParameterPool::Statistics statistics = pool.ResetStatistics();
+        REQUIRE(statistics.Hits == 2);
+        REQUIRE(statistics.Misses == 2);
+
+        for (PooledStatement* statement : statements)
+            delete statement;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "UpdateMaskBits.h"
+#include <array>
+
+TEST_CASE("Update mask field selection", "[UpdateMask]")
+{
+    // 40 fields in two blocks, visibility masks sized for a larger type like the player sized ones units use
+    uint32 const valuesCount = 40;
+    std::array<uint32, 3> visible = { 0x0000F0F0, 0xFFFFFFFF, 0xFFFFFFFF };
+    std::array<uint32, 3> notify = { 0x00000001, 0x00000000, 0x00000000 };
+    std::array<uint32, 3> changes = { 0x000000FF, 0x00000003, 0x00000000 };
+    std::array<uint32, valuesCount> values = { };
+    std::array<uint32, 3> mask = { };
+
+    SECTION("Values update selects visible fields that changed")
+    {
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, true, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[0] == (0x000000F0 | 0x00000001));
+        REQUIRE(mask[1] == 0x00000003);
+    }
+
+    SECTION("Create update selects visible fields that are not zero")
+    {
+        values[4] = 1;
+        values[12] = 1;
+        values[3] = 1; // not visible
+        values[33] = 1;
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, false, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[0] == ((1u << 4) | (1u << 12) | 0x00000001));
+        REQUIRE(mask[1] == (1u << 1));
+    }
+
+    SECTION("Notify flags select fields that are neither visible nor changed")
+    {
+        notify[0] = 0x00010000;
+        notify[1] = 0x00000080;
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, true, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[0] == (0x000000F0 | 0x00010000));
+        REQUIRE(mask[1] == (0x00000003 | 0x00000080));
+    }
+
+    SECTION("Fields past the value count are never selected")
+    {
+        changes[1] = 0xFFFFFFFF;
+        notify[1] = 0xFFFFFF00;
+        for (uint32& value : values)
+            value = 1;
+
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, true, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[1] == 0x000000FF);
+        REQUIRE(mask[2] == 0);
+
+        mask = { };
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, false, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[1] == 0x000000FF);
+        REQUIRE(mask[2] == 0);
+    }
+
+    SECTION("Selection keeps bits that were already set")
+    {
+        mask[1] = 0x00000010;
+        UpdateMaskBits::SelectFields(mask.data(), valuesCount, true, changes.data(), values.data(), visible.data(), notify.data());
+        REQUIRE(mask[1] == (0x00000003 | 0x00000010));
+    }
+}
+
+TEST_CASE("Update mask block count", "[UpdateMask]")
+{
+    std::array<uint32, 4> mask = { };
+    REQUIRE(UpdateMaskBits::CountUsedBlocks(mask.data(), 4) == 1);
+
+    mask[2] = 0x80000000;
+    REQUIRE(UpdateMaskBits::CountUsedBlocks(mask.data(), 4) == 3);
+
+    mask[3] = 1;
+    REQUIRE(UpdateMaskBits::CountUsedBlocks(mask.data(), 4) == 4);
+}
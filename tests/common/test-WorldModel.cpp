@@ -0,0 +1,106 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "ModelIgnoreFlags.h"
+#include "WorldModel.h"
+#include <cstdio>
+#include <random>
+
+namespace
+{
+VMAP::GroupModel MakeGroup(std::mt19937& rng, G3D::Vector3 const& origin, uint32 liquidTiles)
+{
+    std::uniform_real_distribution<float> offset(0.0f, 20.0f);
+    std::vector<G3D::Vector3> vertices;
+    std::vector<VMAP::MeshTriangle> triangles;
+    for (uint32 i = 0; i < 300; ++i)
+    {
+        uint32 first = uint32(vertices.size());
+        G3D::Vector3 corner = origin + G3D::Vector3(offset(rng), offset(rng), offset(rng));
+        vertices.push_back(corner);
+        vertices.push_back(corner + G3D::Vector3(offset(rng) * 0.1f, offset(rng) * 0.1f, 0.0f));
+        vertices.push_back(corner + G3D::Vector3(0.0f, offset(rng) * 0.1f, offset(rng) * 0.1f));
+        triangles.emplace_back(first, first + 1, first + 2);
+    }
+
+    G3D::AABox bounds(vertices[0]);
+    for (G3D::Vector3 const& vertex : vertices)
+        bounds.merge(vertex);
+
+    VMAP::GroupModel group(0, 0, bounds);
+    group.setMeshData(vertices, triangles);
+
+    // an odd number of liquid flags leaves the next group misaligned in the file
+    VMAP::WmoLiquid* liquid = new VMAP::WmoLiquid(liquidTiles, liquidTiles, origin, 1);
+    for (uint32 i = 0; i < (liquidTiles + 1) * (liquidTiles + 1); ++i)
+        liquid->GetHeightStorage()[i] = origin.z;
+    for (uint32 i = 0; i < liquidTiles * liquidTiles; ++i)
+        liquid->GetFlagsStorage()[i] = 0;
+    group.setLiquidData(liquid);
+    return group;
+}
+}
+
+TEST_CASE("World models read back from files intersect like the built ones", "[WorldModel]")
+{
+    std::mt19937 rng(1337);
+    std::vector<VMAP::GroupModel> groups;
+    groups.push_back(MakeGroup(rng, G3D::Vector3(0.0f, 0.0f, 0.0f), 3));
+    groups.push_back(MakeGroup(rng, G3D::Vector3(15.0f, 5.0f, 0.0f), 2));
+    groups.push_back(MakeGroup(rng, G3D::Vector3(5.0f, 15.0f, 5.0f), 3));
+
+    VMAP::WorldModel built;
+    built.setRootWmoID(42);
+    built.setGroupModels(groups);
+
+    std::string const path = "test-WorldModel.vmo";
+    REQUIRE(built.writeFile(path));
+
+    VMAP::WorldModel mapped;
+    VMAP::WorldModel read;
+    REQUIRE(mapped.readFile(path, true));
+    REQUIRE(read.readFile(path, false));
+    std::remove(path.c_str());
+
+    std::uniform_real_distribution<float> position(-5.0f, 45.0f);
+    uint32 hits = 0;
+    for (uint32 i = 0; i < 2000; ++i)
+    {
+        G3D::Vector3 start(position(rng), position(rng), position(rng));
+        G3D::Vector3 end(position(rng), position(rng), position(rng));
+        float const length = (end - start).magnitude();
+        G3D::Ray ray = G3D::Ray::fromOriginAndDirection(start, (end - start) / length);
+
+        float builtDistance = length, mappedDistance = length, readDistance = length;
+        bool builtHit = built.IntersectRay(ray, builtDistance, false, VMAP::ModelIgnoreFlags::Nothing);
+        REQUIRE(mapped.IntersectRay(ray, mappedDistance, false, VMAP::ModelIgnoreFlags::Nothing) == builtHit);
+        REQUIRE(read.IntersectRay(ray, readDistance, false, VMAP::ModelIgnoreFlags::Nothing) == builtHit);
+        REQUIRE(mappedDistance == builtDistance);
+        REQUIRE(readDistance == builtDistance);
+        hits += builtHit;
+    }
+
+    CHECK(hits > 0);
+
+    std::vector<VMAP::GroupModel> readGroups;
+    mapped.getGroupModels(readGroups);
+    REQUIRE(readGroups.size() == 3);
+    float level = 0.0f;
+    CHECK(readGroups[2].GetLiquidLevel(G3D::Vector3(6.0f, 16.0f, 10.0f), level));
+    CHECK(level == 5.0f);
+}